@@ -0,0 +1,190 @@
+#include "Harness.hpp"
+#include <spdlog/fmt/fmt.h>
+#include <charconv>
+#include <fstream>
+#include <utility>
+
+namespace teh::bench
+{
+    namespace
+    {
+        /**
+         * @brief Extract the value following "key": on a line, empty if absent
+         */
+        std::string findField(const std::string& line, const std::string& key)
+        {
+            const std::string pattern = "\"" + key + "\":";
+            size_t position = line.find(pattern);
+            if (position == std::string::npos)
+            {
+                return {};
+            }
+
+            position = line.find_first_not_of(' ', position + pattern.size());
+            if (position == std::string::npos)
+            {
+                return {};
+            }
+
+            if (line[position] == '"')
+            {
+                const size_t end = line.find('"', position + 1);
+                return end == std::string::npos ? std::string{} : line.substr(position + 1, end - position - 1);
+            }
+
+            const size_t end = line.find_first_of(",}", position);
+            return line.substr(position, end == std::string::npos ? std::string::npos : end - position);
+        }
+
+        /**
+         * @brief Parse a whole field as a number, false if it is missing or malformed
+         */
+        template <typename T>
+        bool parseField(const std::string& line, const std::string& key, T& value)
+        {
+            const std::string text = findField(line, key);
+            const char* end = text.data() + text.size();
+            const auto [parsed, error] = std::from_chars(text.data(), end, value);
+            return !text.empty() && error == std::errc{} && parsed == end;
+        }
+    }
+
+    Harness::Harness(const uint32_t samples, std::string filter)
+        : m_Samples(std::max(samples, 1u))
+          , m_Filter(std::move(filter))
+    {
+    }
+
+    bool Harness::isSelected(const std::string& name) const
+    {
+        return m_Filter.empty() || name.find(m_Filter) != std::string::npos;
+    }
+
+    void Harness::record(const std::string& name, const uint64_t operations, std::vector<double>& nsPerOp)
+    {
+        std::ranges::sort(nsPerOp);
+
+        Result result;
+        result.name = name;
+        result.operations = operations;
+        result.samples = static_cast<uint32_t>(nsPerOp.size());
+        result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+        result.minNsPerOp = nsPerOp.front();
+        result.maxNsPerOp = nsPerOp.back();
+        m_Results.push_back(result);
+
+        fmt::print("  {:<32} {:>14.3f} ns/op\n", name, result.nsPerOp);
+    }
+
+    void Harness::print() const
+    {
+        fmt::print("\n{:<32} {:>12} {:>14} {:>14} {:>14}\n", "kernel", "ops/sample", "median ns/op", "min ns/op", "max ns/op");
+        for (const auto& result : m_Results)
+        {
+            fmt::print("{:<32} {:>12} {:>14.3f} {:>14.3f} {:>14.3f}\n",
+                       result.name, result.operations, result.nsPerOp, result.minNsPerOp, result.maxNsPerOp);
+        }
+    }
+
+    bool Harness::writeJson(const std::string& path, const uint32_t seed) const
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            fmt::print(stderr, "Cannot write {}\n", path);
+            return false;
+        }
+
+        out << "{\n";
+        out << fmt::format("  \"version\": 1,\n  \"seed\": {},\n  \"kernels\": [\n", seed);
+        for (size_t i = 0; i < m_Results.size(); ++i)
+        {
+            const auto& result = m_Results[i];
+            out << fmt::format("    {{\"name\": \"{}\", \"operations\": {}, \"samples\": {}, "
+                               "\"ns_per_op\": {:.4f}, \"min_ns_per_op\": {:.4f}, \"max_ns_per_op\": {:.4f}}}{}\n",
+                               result.name, result.operations, result.samples,
+                               result.nsPerOp, result.minNsPerOp, result.maxNsPerOp,
+                               i + 1 < m_Results.size() ? "," : "");
+        }
+        out << "  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+    bool Harness::readJson(const std::string& path, std::vector<Result>& results, uint32_t& seed)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            fmt::print(stderr, "Cannot read {}\n", path);
+            return false;
+        }
+
+        bool hasSeed = false;
+        std::string line;
+        for (uint32_t lineNumber = 1; std::getline(in, line); ++lineNumber)
+        {
+            if (line.find("\"seed\":") != std::string::npos)
+            {
+                if (!parseField(line, "seed", seed))
+                {
+                    fmt::print(stderr, "Cannot read {}: invalid seed on line {}\n", path, lineNumber);
+                    return false;
+                }
+                hasSeed = true;
+                continue;
+            }
+
+            const std::string name = findField(line, "name");
+            if (name.empty())
+            {
+                continue;
+            }
+
+            Result result;
+            result.name = name;
+            if (!parseField(line, "operations", result.operations) ||
+                !parseField(line, "samples", result.samples) ||
+                !parseField(line, "ns_per_op", result.nsPerOp) ||
+                !parseField(line, "min_ns_per_op", result.minNsPerOp) ||
+                !parseField(line, "max_ns_per_op", result.maxNsPerOp))
+            {
+                fmt::print(stderr, "Cannot read {}: incomplete kernel '{}' on line {}\n", path, name, lineNumber);
+                return false;
+            }
+            results.push_back(result);
+        }
+
+        if (!hasSeed)
+        {
+            fmt::print(stderr, "Cannot read {}: no seed recorded\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    bool Harness::compare(const std::vector<Result>& baseline, const std::vector<Result>& current, const double threshold)
+    {
+        bool passed = true;
+
+        fmt::print("\n{:<32} {:>14} {:>14} {:>9}\n", "kernel", "baseline ns/op", "current ns/op", "ratio");
+        for (const auto& result : current)
+        {
+            const auto it = std::ranges::find(baseline, result.name, &Result::name);
+            if (it == baseline.end() || it->nsPerOp <= 0.0)
+            {
+                fmt::print("{:<32} {:>14} {:>14.3f} {:>9}\n", result.name, "-", result.nsPerOp, "new");
+                continue;
+            }
+
+            const double ratio = result.nsPerOp / it->nsPerOp;
+            const bool regressed = ratio > 1.0 + threshold;
+            passed = passed && !regressed;
+
+            fmt::print("{:<32} {:>14.3f} {:>14.3f} {:>8.2f}x{}\n",
+                       result.name, it->nsPerOp, result.nsPerOp, ratio, regressed ? "  REGRESSION" : "");
+        }
+
+        fmt::print("\n{} (threshold +{:.0f} %)\n", passed ? "No regressions" : "Regressions found", threshold * 100.0);
+        return passed;
+    }
+}
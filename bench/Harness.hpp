@@ -0,0 +1,135 @@
+#ifndef THEELDERWOODHILL_BENCH_HARNESS_HPP
+#define THEELDERWOODHILL_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace teh::bench
+{
+    /**
+     * @brief Keep a value alive so the optimizer cannot drop the work producing it
+     */
+    template <typename T>
+    inline void keep(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Timing of one kernel
+     */
+    struct Result
+    {
+        std::string name;
+        uint64_t operations{};      // Operations per sample
+        uint32_t samples{};
+        double nsPerOp{};           // Median over samples
+        double minNsPerOp{};
+        double maxNsPerOp{};
+    };
+
+    /**
+     * @brief Runs kernels, collects their timings and compares them against a baseline
+     *
+     * Every kernel runs one untimed warm-up pass, then a fixed number of timed
+     * samples. The median per-operation time is what gets compared, so a single
+     * sample disturbed by the scheduler does not flag a regression.
+     */
+    class Harness
+    {
+    public:
+        /**
+         * @param samples Timed samples per kernel
+         * @param filter Only kernels whose name contains this run; empty runs all
+         */
+        Harness(uint32_t samples, std::string filter);
+
+        /**
+         * @brief Whether a kernel passes the name filter
+         */
+        bool isSelected(const std::string& name) const;
+
+        /**
+         * @brief Time a kernel
+         * @param name Stable identifier, used as the key in baselines
+         * @param operations Number of operations one call of kernel performs
+         * @param setup Untimed preparation before every sample
+         * @param kernel Work under measurement
+         */
+        template <typename Setup, typename Kernel>
+        void run(const std::string& name, const uint64_t operations, Setup&& setup, Kernel&& kernel)
+        {
+            if (!isSelected(name) || operations == 0)
+            {
+                return;
+            }
+
+            setup();
+            kernel();
+
+            std::vector<double> nsPerOp;
+            nsPerOp.reserve(m_Samples);
+            for (uint32_t sample = 0; sample < m_Samples; ++sample)
+            {
+                setup();
+                const auto start = std::chrono::steady_clock::now();
+                kernel();
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                nsPerOp.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(operations));
+            }
+
+            record(name, operations, nsPerOp);
+        }
+
+        template <typename Kernel>
+        void run(const std::string& name, const uint64_t operations, Kernel&& kernel)
+        {
+            run(name, operations, [] {}, kernel);
+        }
+
+        const std::vector<Result>& getResults() const { return m_Results; }
+
+        /**
+         * @brief Print a result table to stdout
+         */
+        void print() const;
+
+        /**
+         * @brief Write the results as JSON
+         * @param seed Seed of the synthetic inputs, stored so baselines from other inputs are noticed
+         */
+        bool writeJson(const std::string& path, uint32_t seed) const;
+
+        /**
+         * @brief Read results written by writeJson()
+         *
+         * Not a general JSON parser: it relies on writeJson() putting one kernel per line.
+         * @return false if the file cannot be opened, has no seed or a kernel misses a field
+         */
+        static bool readJson(const std::string& path, std::vector<Result>& results, uint32_t& seed);
+
+        /**
+         * @brief Compare results against a baseline and print the ratios
+         * @param threshold Allowed slowdown, 0.1 meaning 10 %
+         * @return false if any kernel regressed beyond the threshold
+         */
+        static bool compare(const std::vector<Result>& baseline, const std::vector<Result>& current, double threshold);
+
+    private:
+        void record(const std::string& name, uint64_t operations, std::vector<double>& nsPerOp);
+
+        uint32_t m_Samples;
+        std::string m_Filter;
+        std::vector<Result> m_Results;
+    };
+}
+
+#endif //THEELDERWOODHILL_BENCH_HARNESS_HPP
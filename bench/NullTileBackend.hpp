@@ -0,0 +1,47 @@
+#ifndef THEELDERWOODHILL_BENCH_NULLTILEBACKEND_HPP
+#define THEELDERWOODHILL_BENCH_NULLTILEBACKEND_HPP
+
+#include "Map/TileBackend.hpp"
+
+namespace teh::bench
+{
+    class NullTilesetSet : public map::TilesetSet
+    {
+    public:
+        void getStats(std::vector<map::TextureStats>&) const override {}
+    };
+
+    /**
+     * @brief Tile backend that only counts submitted tiles
+     *
+     * Keeps driver and GPU cost out of the renderer kernels; what remains is
+     * animation resolution, culling and instance building.
+     */
+    class NullTileBackend : public map::TileBackend
+    {
+    public:
+        const char* getName() const override { return "null"; }
+
+        map::TilesetSet* createTilesets(const tmx::render::MapRenderData&, const map::TilesetImages&) override
+        {
+            return new NullTilesetSet();
+        }
+
+        void beginFrame() override { resetDrawCalls(); }
+        void drawTiles(std::span<const map::TileInstance> tiles, uint32_t) override { m_Tiles += tiles.size(); }
+        void endFrame() override {}
+
+        void getOutputSize(int& width, int& height) const override
+        {
+            width = 0;
+            height = 0;
+        }
+
+        uint64_t getTileCount() const { return m_Tiles; }
+
+    private:
+        uint64_t m_Tiles{};
+    };
+}
+
+#endif //THEELDERWOODHILL_BENCH_NULLTILEBACKEND_HPP
@@ -0,0 +1,172 @@
+#include "SyntheticMap.hpp"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/fmt/fmt.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace teh::bench
+{
+    namespace
+    {
+        // Tiled stores flips in the top bits of a GID
+        constexpr uint32_t FLIP_HORIZONTAL = 0x80000000u;
+        constexpr uint32_t FLIP_VERTICAL = 0x40000000u;
+        constexpr uint32_t FLIP_DIAGONAL = 0x20000000u;
+
+        constexpr const char* TILESET_IMAGE = "synthetic_tiles.png";
+
+        bool chance(std::mt19937& random, const uint32_t perMille)
+        {
+            return random() % 1000 < perMille;
+        }
+
+        bool writeTilesetImage(const SyntheticMapConfig& config, std::mt19937& random, const std::string& path)
+        {
+            const int tileSize = static_cast<int>(config.tileSize);
+            SDL_Surface* surface = SDL_CreateSurface(static_cast<int>(config.tilesetColumns) * tileSize,
+                                                     static_cast<int>(config.tilesetRows) * tileSize,
+                                                     SDL_PIXELFORMAT_RGBA32);
+            if (!surface)
+            {
+                return false;
+            }
+
+            // Flat tiles with a few translucent ones, enough for a realistic premultiply pass
+            for (uint32_t row = 0; row < config.tilesetRows; ++row)
+            {
+                for (uint32_t column = 0; column < config.tilesetColumns; ++column)
+                {
+                    const SDL_Rect rect = {static_cast<int>(column) * tileSize, static_cast<int>(row) * tileSize, tileSize, tileSize};
+                    const uint32_t color = random();
+                    const auto alpha = static_cast<Uint8>(chance(random, 200) ? 128 : 255);
+                    SDL_FillSurfaceRect(surface, &rect, SDL_MapSurfaceRGBA(surface, color & 0xff, (color >> 8) & 0xff,
+                                                                           (color >> 16) & 0xff, alpha));
+                }
+            }
+
+            const bool saved = IMG_SavePNG(surface, path.c_str());
+            SDL_DestroySurface(surface);
+            return saved;
+        }
+
+        void writeTileset(std::ofstream& out, const SyntheticMapConfig& config, std::mt19937& random)
+        {
+            const uint32_t tileCount = config.tilesetColumns * config.tilesetRows;
+
+            out << fmt::format(R"( <tileset firstgid="1" name="synthetic" tilewidth="{0}" tileheight="{0}" tilecount="{1}" columns="{2}">)",
+                               config.tileSize, tileCount, config.tilesetColumns) << '\n';
+            out << fmt::format(R"(  <image source="{}" width="{}" height="{}"/>)",
+                               TILESET_IMAGE, config.tilesetColumns * config.tileSize, config.tilesetRows * config.tileSize) << '\n';
+
+            for (uint32_t id = 0; id < config.animations && id < tileCount; ++id)
+            {
+                out << fmt::format(R"(  <tile id="{}">)", id) << "\n   <animation>\n";
+                for (uint32_t frame = 0; frame < config.framesPerAnimation; ++frame)
+                {
+                    const uint32_t duration = 50 + random() % 21 * 10;
+                    out << fmt::format(R"(    <frame tileid="{}" duration="{}"/>)", random() % tileCount, duration) << '\n';
+                }
+                out << "   </animation>\n  </tile>\n";
+            }
+            out << " </tileset>\n";
+        }
+
+        void writeLayer(std::ofstream& out, const SyntheticMapConfig& config, std::mt19937& random, const uint32_t layer)
+        {
+            const uint32_t tileCount = config.tilesetColumns * config.tilesetRows;
+
+            // One faded layer exercises the translucent tile path
+            const bool faded = layer + 1 == config.layers && config.layers > 1;
+            out << fmt::format(R"( <layer id="{}" name="layer{}" width="{}" height="{}"{}>)",
+                               layer + 1, layer, config.width, config.height, faded ? R"( opacity="0.75")" : "") << '\n';
+            out << R"(  <data encoding="csv">)" << '\n';
+
+            for (uint32_t y = 0; y < config.height; ++y)
+            {
+                for (uint32_t x = 0; x < config.width; ++x)
+                {
+                    uint32_t gid = 0;
+                    if (layer == 0 || chance(random, config.fillPerMille))
+                    {
+                        gid = chance(random, config.animatedPerMille) && config.animations > 0
+                                  ? 1 + random() % config.animations
+                                  : 1 + random() % tileCount;
+
+                        if (chance(random, config.flippedPerMille))
+                        {
+                            constexpr uint32_t flips[] = {FLIP_HORIZONTAL, FLIP_VERTICAL, FLIP_DIAGONAL,
+                                                          FLIP_HORIZONTAL | FLIP_VERTICAL};
+                            gid |= flips[random() % 4];
+                        }
+                    }
+
+                    out << gid;
+                    if (x + 1 < config.width || y + 1 < config.height)
+                    {
+                        out << ',';
+                    }
+                }
+                out << '\n';
+            }
+
+            out << "  </data>\n </layer>\n";
+        }
+
+        void writeObjects(std::ofstream& out, const SyntheticMapConfig& config, std::mt19937& random)
+        {
+            const uint32_t pixelWidth = config.width * config.tileSize;
+            const uint32_t pixelHeight = config.height * config.tileSize;
+
+            out << fmt::format(R"( <objectgroup id="{}" name="triggers">)", config.layers + 1) << '\n';
+            for (uint32_t i = 0; i < config.objects; ++i)
+            {
+                // One draw per statement: argument evaluation order is unspecified and differs between compilers
+                const uint32_t w = config.tileSize * (1 + random() % 4);
+                const uint32_t h = config.tileSize * (1 + random() % 4);
+                const uint32_t x = random() % pixelWidth;
+                const uint32_t y = random() % pixelHeight;
+                out << fmt::format(R"(  <object id="{}" name="object{}" type="trigger" x="{}" y="{}" width="{}" height="{}"/>)",
+                                   i + 1, i, x, y, w, h) << '\n';
+            }
+            out << " </objectgroup>\n";
+        }
+    }
+
+    bool writeSyntheticMap(const SyntheticMapConfig& config, const std::string& directory, std::string& tmxPath)
+    {
+        std::mt19937 random(config.seed);
+
+        const std::filesystem::path base(directory);
+        if (!writeTilesetImage(config, random, (base / TILESET_IMAGE).string()))
+        {
+            fmt::print(stderr, "Failed to write the synthetic tileset: {}\n", SDL_GetError());
+            return false;
+        }
+
+        tmxPath = (base / "synthetic.tmx").string();
+        std::ofstream out(tmxPath, std::ios::trunc);
+        if (!out)
+        {
+            fmt::print(stderr, "Cannot write {}\n", tmxPath);
+            return false;
+        }
+
+        out << R"(<?xml version="1.0" encoding="UTF-8"?>)" << '\n';
+        out << fmt::format(R"(<map version="1.10" orientation="orthogonal" renderorder="right-down" width="{}" height="{}" )"
+                           R"(tilewidth="{}" tileheight="{}" infinite="0" nextlayerid="{}" nextobjectid="{}">)",
+                           config.width, config.height, config.tileSize, config.tileSize,
+                           config.layers + 2, config.objects + 1) << '\n';
+
+        writeTileset(out, config, random);
+        for (uint32_t layer = 0; layer < config.layers; ++layer)
+        {
+            writeLayer(out, config, random, layer);
+        }
+        writeObjects(out, config, random);
+
+        out << "</map>\n";
+        return static_cast<bool>(out);
+    }
+}
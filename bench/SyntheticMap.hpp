@@ -0,0 +1,42 @@
+#ifndef THEELDERWOODHILL_BENCH_SYNTHETICMAP_HPP
+#define THEELDERWOODHILL_BENCH_SYNTHETICMAP_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace teh::bench
+{
+    /**
+     * @brief Shape of the generated benchmark map
+     *
+     * Ratios are in per mille, so the generated content only depends on the
+     * std::mt19937 output sequence, which the standard pins down exactly.
+     */
+    struct SyntheticMapConfig
+    {
+        uint32_t seed = 0x7e40d;
+        uint32_t width = 256;               // Tiles
+        uint32_t height = 256;
+        uint32_t layers = 4;                // Layer 0 is fully filled, the rest are sparse
+        uint32_t tileSize = 16;
+        uint32_t tilesetColumns = 32;
+        uint32_t tilesetRows = 32;
+        uint32_t animations = 64;           // Animated tile ids 0..animations-1
+        uint32_t framesPerAnimation = 8;
+        uint32_t fillPerMille = 350;        // Occupancy of the sparse layers
+        uint32_t animatedPerMille = 50;
+        uint32_t flippedPerMille = 50;
+        uint32_t objects = 2000;
+    };
+
+    /**
+     * @brief Write a TMX map and its tileset PNG into a directory
+     * @param config Map shape and seed
+     * @param directory Existing directory receiving the files
+     * @param tmxPath Receives the path of the written map
+     * @return true if both files were written
+     */
+    bool writeSyntheticMap(const SyntheticMapConfig& config, const std::string& directory, std::string& tmxPath);
+}
+
+#endif //THEELDERWOODHILL_BENCH_SYNTHETICMAP_HPP
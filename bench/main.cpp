@@ -0,0 +1,324 @@
+#include "Harness.hpp"
+#include "NullTileBackend.hpp"
+#include "SyntheticMap.hpp"
+#include "Map/Animation.hpp"
+#include "Map/Map.hpp"
+#include "Map/Objects.hpp"
+#include "Map/Renderer.hpp"
+#include "Utils/Logger.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+using teh::bench::Harness;
+using teh::bench::keep;
+
+// Lookups per sample for the animation kernels
+static constexpr uint32_t ANIMATION_LOOKUPS = 1 << 16;
+
+// Live clocks and steps per sample for the animation update kernel
+static constexpr uint32_t UPDATE_STATES = 4096;
+static constexpr uint32_t UPDATE_STEPS = 64;
+
+struct BenchOptions
+{
+    std::string outputPath;         // Write results as JSON
+    std::string baselinePath;       // Compare against a stored result file
+    std::string filter;             // Only run kernels whose name contains this
+    double threshold = 0.15;        // Allowed slowdown before a kernel counts as regressed
+    uint32_t samples = 15;
+    uint32_t seed = teh::bench::SyntheticMapConfig{}.seed;
+};
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --output <file>     Write results as JSON to <file>\n"
+              << "  --compare <file>    Compare against a baseline written by --output, exit 1 on regression\n"
+              << "  --threshold <pct>   Allowed slowdown per kernel in percent (default 15)\n"
+              << "  --samples <n>       Timed samples per kernel (default 15)\n"
+              << "  --filter <text>     Only run kernels whose name contains <text>\n"
+              << "  --seed <n>          Seed of the synthetic inputs\n";
+}
+
+/**
+ * @brief Parse a whole command line value as a number, false if it is malformed or out of range
+ */
+template <typename T>
+static bool parseNumber(const char* text, T& value)
+{
+    const char* end = text + std::strlen(text);
+    const auto [parsed, error] = std::from_chars(text, end, value);
+    return parsed != text && error == std::errc{} && parsed == end;
+}
+
+static void runAnimationKernels(Harness& harness, const tmx::render::MapRenderData& renderData, std::mt19937& random)
+{
+    // Every clock the renderer would look up, hit in random order
+    std::vector<std::pair<uint32_t, uint32_t>> keys;
+    std::vector<const tmx::render::AnimationRenderInfo*> animations;
+    for (uint32_t tileset = 0; tileset < renderData.tilesets.size(); ++tileset)
+    {
+        const auto& tilesetAnimations = renderData.tilesets[tileset].animations;
+        for (uint32_t animation = 0; animation < tilesetAnimations.size(); ++animation)
+        {
+            keys.emplace_back(tileset, animation);
+            if (tilesetAnimations[animation].totalDuration > 0)
+            {
+                animations.push_back(&tilesetAnimations[animation]);
+            }
+        }
+    }
+
+    if (keys.empty() || animations.empty())
+    {
+        std::cerr << "Synthetic map has no animations, skipping animation kernels\n";
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> lookups(ANIMATION_LOOKUPS);
+    for (auto& lookup : lookups)
+    {
+        lookup = keys[random() % keys.size()];
+    }
+
+    teh::map::AnimationStateManager states;
+    harness.run("animation.get_state", lookups.size(), [&] {
+        uint32_t sum = 0;
+        for (const auto& [tileset, animation] : lookups)
+        {
+            sum += states.getState(tileset, animation).elapsedTime;
+        }
+        keep(sum);
+    });
+
+    // A whole world holds far more clocks than one synthetic tileset
+    teh::map::AnimationStateManager manyStates;
+    for (uint32_t i = 0; i < UPDATE_STATES; ++i)
+    {
+        manyStates.getState(i / 64, i % 64);
+    }
+    harness.run("animation.update", static_cast<uint64_t>(UPDATE_STATES) * UPDATE_STEPS, [&] {
+        for (uint32_t step = 0; step < UPDATE_STEPS; ++step)
+        {
+            manyStates.update(16);
+        }
+        keep(manyStates.getState(0, 0).elapsedTime);
+    });
+
+    // Times already wrapped into the cycle, as Renderer::renderBucket does
+    std::vector<std::pair<const tmx::render::AnimationRenderInfo*, uint32_t>> frameLookups(ANIMATION_LOOKUPS);
+    for (auto& [animation, time] : frameLookups)
+    {
+        animation = animations[random() % animations.size()];
+        time = random() % animation->totalDuration;
+    }
+    harness.run("animation.frame_index", frameLookups.size(), [&] {
+        uint32_t sum = 0;
+        for (const auto& [animation, time] : frameLookups)
+        {
+            sum += animation->getFrameIndexAtTime(time);
+        }
+        keep(sum);
+    });
+}
+
+static void runRendererKernels(Harness& harness, const tmx::render::MapRenderData& renderData, uint64_t tileCount)
+{
+    teh::bench::NullTileBackend backend;
+    teh::map::Renderer renderer(backend);
+    renderer.prepare(renderData);
+
+    // Every tile passes culling and becomes an instance
+    teh::map::Camera fullView;
+    fullView.viewportWidth = static_cast<float>(renderData.pixelWidth);
+    fullView.viewportHeight = static_cast<float>(renderData.pixelHeight);
+    harness.run("renderer.full_view", tileCount, [&] {
+        renderer.render(renderData, fullView, 16);
+    });
+
+    // A window-sized view in the middle: per-tile cost is dominated by the cull test
+    teh::map::Camera windowView;
+    windowView.viewportWidth = 640.0f;
+    windowView.viewportHeight = 480.0f;
+    windowView.x = (static_cast<float>(renderData.pixelWidth) - windowView.viewportWidth) * 0.5f;
+    windowView.y = (static_cast<float>(renderData.pixelHeight) - windowView.viewportHeight) * 0.5f;
+    harness.run("renderer.culled_view", tileCount, [&] {
+        renderer.render(renderData, windowView, 16);
+    });
+
+    keep(backend.getTileCount());
+}
+
+static void runLoadKernels(Harness& harness, const std::string& tmxPath, const tmx::Map& map,
+                           const tmx::render::MapRenderData& renderData, uint64_t tileCount)
+{
+    const std::string basePath = fs::path(tmxPath).parent_path().string();
+    teh::bench::NullTileBackend backend;
+
+    harness.run("load.parse", 1, [&] {
+        const auto result = tmx::Parser::parseFromFile(tmxPath);
+        keep(result.has_value());
+    });
+
+    harness.run("load.render_data", 1, [&] {
+        const auto data = tmx::render::createRenderData(map, basePath);
+        keep(data.layers.size());
+    });
+
+    teh::map::Renderer renderer(backend);
+    harness.run("load.renderer_prepare", tileCount, [&] {
+        renderer.prepare(renderData);
+    });
+
+    teh::map::ObjectStore objects;
+    harness.run("load.objects", 1, [&] {
+        objects.load(map);
+        keep(objects.size());
+    });
+
+    // Straight decode, the on-disk texture cache is left out
+    harness.run("load.decode_tilesets", 1, [&] {
+        teh::map::TilesetImages images;
+        keep(backend.decodeTilesets(renderData, images));
+    });
+
+    harness.run("load.map_prepare", 1, [&] {
+        teh::map::Map loaded(backend);
+        keep(loaded.prepare(tmxPath));
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            options.outputPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+        {
+            options.baselinePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            double percent = 0.0;
+            if (!parseNumber(argv[++i], percent) || !std::isfinite(percent) || percent < 0.0)
+            {
+                std::cerr << "Invalid threshold '" << argv[i] << "'\n";
+                printUsage(argv[0]);
+                return 2;
+            }
+            options.threshold = percent / 100.0;
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+        {
+            if (!parseNumber(argv[++i], options.samples) || options.samples == 0)
+            {
+                std::cerr << "Invalid sample count '" << argv[i] << "'\n";
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            if (!parseNumber(argv[++i], options.seed))
+            {
+                std::cerr << "Invalid seed '" << argv[i] << "'\n";
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Map code logs at INFO while loading; keep the timing output readable
+    teh::utils::Logger::init();
+    teh::utils::Logger::setLevel(spdlog::level::warn);
+
+    teh::bench::SyntheticMapConfig config;
+    config.seed = options.seed;
+
+    const fs::path directory = fs::temp_directory_path() / ("teh_bench_" + std::to_string(options.seed));
+    fs::create_directories(directory);
+
+    std::string tmxPath;
+    if (!teh::bench::writeSyntheticMap(config, directory.string(), tmxPath))
+    {
+        return 2;
+    }
+
+    const auto parsed = tmx::Parser::parseFromFile(tmxPath);
+    if (!parsed)
+    {
+        std::cerr << "Failed to parse the synthetic map: " << parsed.error() << "\n";
+        return 2;
+    }
+    const auto renderData = tmx::render::createRenderData(*parsed, directory.string());
+
+    uint64_t tileCount = 0;
+    for (const auto& layer : renderData.layers)
+    {
+        tileCount += layer.tiles.size();
+    }
+
+    std::cout << "Synthetic map: " << config.width << "x" << config.height << " x " << config.layers
+              << " layers, " << tileCount << " tiles, seed " << options.seed << "\n";
+
+    Harness harness(options.samples, options.filter);
+    std::mt19937 random(options.seed);
+
+    runAnimationKernels(harness, renderData, random);
+    runRendererKernels(harness, renderData, tileCount);
+    runLoadKernels(harness, tmxPath, *parsed, renderData, tileCount);
+
+    harness.print();
+    fs::remove_all(directory);
+
+    int exitCode = 0;
+    if (!options.outputPath.empty() && !harness.writeJson(options.outputPath, options.seed))
+    {
+        exitCode = 2;
+    }
+
+    if (!options.baselinePath.empty())
+    {
+        std::vector<teh::bench::Result> baseline;
+        uint32_t baselineSeed = options.seed;
+        if (!Harness::readJson(options.baselinePath, baseline, baselineSeed))
+        {
+            exitCode = 2;
+        }
+        else if (baselineSeed != options.seed)
+        {
+            // Different synthetic inputs, the timings say nothing about a regression
+            std::cerr << "Baseline was recorded with seed " << baselineSeed << ", this run used " << options.seed
+                      << "; rerun with --seed " << baselineSeed << "\n";
+            exitCode = 2;
+        }
+        else if (!Harness::compare(baseline, harness.getResults(), options.threshold) && exitCode == 0)
+        {
+            exitCode = 1;
+        }
+    }
+
+    teh::utils::Logger::shutdown();
+    return exitCode;
+}
@@ -0,0 +1,44 @@
+# Compile GLSL shaders to SPIR-V and embed them into a target as generated headers.
+# Each <name>.<stage> shader becomes <name>_<stage>_spv.h defining <NAME>_<STAGE>_SPV.
+find_program(GLSLC_EXECUTABLE glslc)
+find_program(GLSLANG_VALIDATOR_EXECUTABLE glslangValidator)
+
+if (GLSLC_EXECUTABLE OR GLSLANG_VALIDATOR_EXECUTABLE)
+    set(TEH_SHADER_COMPILER_FOUND TRUE)
+else ()
+    set(TEH_SHADER_COMPILER_FOUND FALSE)
+endif ()
+
+function(teh_embed_shaders target)
+    set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/shaders")
+    set(headers "")
+
+    foreach (shader ${ARGN})
+        get_filename_component(name ${shader} NAME)
+        string(REPLACE "." "_" symbol ${name})
+        string(TOUPPER "${symbol}_SPV" symbol_upper)
+        set(spirv "${output_dir}/${name}.spv")
+        set(header "${output_dir}/${symbol}_spv.h")
+
+        if (GLSLC_EXECUTABLE)
+            set(compile_command ${GLSLC_EXECUTABLE} -O -o ${spirv} ${shader})
+        else ()
+            set(compile_command ${GLSLANG_VALIDATOR_EXECUTABLE} -V -o ${spirv} ${shader})
+        endif ()
+
+        add_custom_command(
+                OUTPUT ${header}
+                COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+                COMMAND ${compile_command}
+                COMMAND ${CMAKE_COMMAND} -DINPUT=${spirv} -DOUTPUT=${header} -DSYMBOL=${symbol_upper}
+                        -P "${PROJECT_SOURCE_DIR}/cmake/EmbedBinary.cmake"
+                DEPENDS ${shader} "${PROJECT_SOURCE_DIR}/cmake/EmbedBinary.cmake"
+                COMMENT "Compiling shader ${name}"
+                VERBATIM
+        )
+        list(APPEND headers ${header})
+    endforeach ()
+
+    target_sources(${target} PRIVATE ${headers})
+    target_include_directories(${target} PRIVATE ${output_dir})
+endfunction()
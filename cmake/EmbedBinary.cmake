@@ -0,0 +1,7 @@
+# Usage: cmake -DINPUT=<file> -DOUTPUT=<header> -DSYMBOL=<name> -P EmbedBinary.cmake
+file(READ "${INPUT}" content HEX)
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," content "${content}")
+file(WRITE "${OUTPUT}"
+        "#pragma once\n\n"
+        "// Generated from ${INPUT}, do not edit\n"
+        "alignas(4) inline constexpr unsigned char ${SYMBOL}[] = {\n${content}\n};\n")
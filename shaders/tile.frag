@@ -0,0 +1,14 @@
+#version 450
+
+layout(location = 0) in vec3 inUv;
+layout(location = 1) in float inOpacity;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 2, binding = 0) uniform sampler2DArray atlas;
+
+void main()
+{
+    // Tilesets are premultiplied, so opacity scales every channel
+    outColor = texture(atlas, inUv) * inOpacity;
+}
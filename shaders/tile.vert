@@ -0,0 +1,57 @@
+#version 450
+
+// One instanced quad per tile; must match teh::map::TileInstance
+struct TileInstance
+{
+    vec4 dst;       // Screen-space x, y, w, h
+    vec4 src;       // Source rect in tileset pixels
+    float opacity;
+    uint tileset;   // Layer of the atlas array texture
+    uint flags;     // TILE_FLIP_* bits
+    uint padding;
+};
+
+const uint FLIP_HORIZONTAL = 1u;
+const uint FLIP_VERTICAL = 2u;
+const uint FLIP_DIAGONAL = 4u;
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances
+{
+    TileInstance instances[];
+};
+
+layout(std140, set = 1, binding = 0) uniform Frame
+{
+    vec2 viewportSize;
+    vec2 atlasSize;
+};
+
+layout(location = 0) out vec3 outUv;
+layout(location = 1) out float outOpacity;
+
+const vec2 CORNERS[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0),
+    vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+void main()
+{
+    TileInstance tile = instances[gl_InstanceIndex];
+    vec2 corner = CORNERS[gl_VertexIndex];
+
+    vec2 position = tile.dst.xy + corner * tile.dst.zw;
+    vec2 ndc = position / viewportSize * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+
+    // Undo Tiled's flips (diagonal, then horizontal, then vertical) to find the source texel
+    vec2 uv = corner;
+    if ((tile.flags & FLIP_VERTICAL) != 0u)
+        uv.y = 1.0 - uv.y;
+    if ((tile.flags & FLIP_HORIZONTAL) != 0u)
+        uv.x = 1.0 - uv.x;
+    if ((tile.flags & FLIP_DIAGONAL) != 0u)
+        uv = uv.yx;
+
+    outUv = vec3((tile.src.xy + uv * tile.src.zw) / atlasSize, float(tile.tileset));
+    outOpacity = tile.opacity;
+}
@@ -1,10 +1,27 @@
 #include "Game.hpp"
 #include "Utils/Logger.hpp"
+#include "Utils/Profiler.hpp"
+#include "Map/SdlTileBackend.hpp"
+#ifdef TEH_ENABLE_GPU_BACKEND
+#include "Map/GpuTileBackend.hpp"
+#endif
 #include <iostream>
+#include <thread>
 
 static std::string ASSETS_PATH(TEH_ASSETS_PATH);
 
-Game::Game() : isRunning(false), window(nullptr), renderer(nullptr), map(nullptr), lastTime(0)
+// Screen pixels moved per arrow key press
+static constexpr float CAMERA_PAN_STEP = 32.0f;
+
+// Refresh period of the FPS counter and the overlay's map statistics
+static constexpr uint64_t TELEMETRY_REFRESH_MS = 500;
+
+// Period of the map statistics dump while profiling
+static constexpr uint64_t TELEMETRY_LOG_MS = 10000;
+
+Game::Game() : isRunning(false), window(nullptr), renderer(nullptr), tileBackend(nullptr), textureCache(nullptr), world(nullptr), minimap(nullptr),
+               debugOverlay(nullptr), recorder(nullptr), replayPlayer(nullptr), lastTime(0), renderedTime(0),
+               statsTime(0), telemetryLogTime(0), fpsTime(0), fpsFrames(0), fps(0.0f)
 {
 }
 
@@ -13,16 +30,27 @@ Game::~Game()
     cleanup();
 }
 
-bool Game::init()
+bool Game::init(const LaunchOptions& launchOptions)
 {
     // Initialize logger first
     teh::utils::Logger::init();
     
     TEH_GAME_LOG(INFO, "Initializing game...");
+
+    options = launchOptions;
+    teh::utils::Profiler::setEnabled(options.profile);
+
+    if (options.headless)
+    {
+        // No display needed: the offscreen video driver backs both the software renderer and headless Vulkan
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+        TEH_GAME_LOG(INFO, "Running headless");
+    }
     
     SDL_Init(SDL_INIT_VIDEO);
 
-    window = SDL_CreateWindow("古树之丘", 640, 480, 0);
+    window = SDL_CreateWindow("古树之丘", 640, 480, options.headless ? SDL_WINDOW_HIDDEN : 0);
     if (!window)
     {
         TEH_GRAPHICS_LOG(ERROR, "SDL_CreateWindow Error: {}", SDL_GetError());
@@ -30,24 +58,85 @@ bool Game::init()
         return false;
     }
 
-    renderer = SDL_CreateRenderer(window, nullptr);
-    if (!renderer)
+    if (options.gpu)
     {
-        TEH_GRAPHICS_LOG(ERROR, "SDL_CreateRenderer Error: {}", SDL_GetError());
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return false;
+#ifdef TEH_ENABLE_GPU_BACKEND
+        tileBackend = teh::map::GpuTileBackend::create(window, options.headless);
+        if (!tileBackend)
+        {
+            TEH_GRAPHICS_LOG(WARN, "SDL_GPU backend unavailable, falling back to SDL_Renderer");
+        }
+#else
+        TEH_GRAPHICS_LOG(WARN, "Built without the SDL_GPU backend, falling back to SDL_Renderer");
+#endif
+    }
+
+    if (!tileBackend)
+    {
+        renderer = SDL_CreateRenderer(window, nullptr);
+        if (!renderer)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "SDL_CreateRenderer Error: {}", SDL_GetError());
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            return false;
+        }
+        tileBackend = new teh::map::SdlTileBackend(renderer);
     }
 
-    map = new teh::map::Map(renderer);
-    if (!map->load(ASSETS_PATH + "maps/tests/dungeon/dungeon.tmx"))
+    TEH_GRAPHICS_LOG(INFO, "Tile backend: {}", tileBackend->getName());
+
+    textureCache = new teh::utils::TextureCache(options.textureCache ? teh::utils::TextureCache::getDefaultDirectory() : "");
+    tileBackend->setTextureCache(textureCache);
+
+    // Neighbouring maps get registered and linked here; they load in the background as the view nears them
+    world = new teh::map::World(*tileBackend);
+    world->addMap("dungeon", ASSETS_PATH + "maps/tests/dungeon/dungeon.tmx", {});
+    if (!world->enter("dungeon"))
     {
         TEH_GAME_LOG(ERROR, "Failed to load map");
         return false;
     }
 
+    int outputWidth = 0;
+    int outputHeight = 0;
+    tileBackend->getOutputSize(outputWidth, outputHeight);
+    state.camera.viewportWidth = static_cast<float>(outputWidth);
+    state.camera.viewportHeight = static_cast<float>(outputHeight);
+
+    // UI overlays are drawn through SDL_Renderer
+    if (renderer)
+    {
+        minimap = new teh::ui::Minimap(renderer);
+        minimap->setArea({static_cast<float>(outputWidth) - 170.0f, 10.0f, 160.0f, 120.0f});
+        debugOverlay = new teh::ui::DebugOverlay(renderer);
+    }
+
+    // The simulation owns these toggles from now on, the renderer applies them per snapshot
+    state.minimapVisible = minimap && minimap->isVisible();
+    state.lightingEnabled = world->getCurrentMap()->getLighting().isEnabled();
+
+    if (!options.replayPath.empty())
+    {
+        replayPlayer = new teh::utils::ReplayPlayer();
+        if (!replayPlayer->open(options.replayPath))
+        {
+            return false;
+        }
+    }
+    else if (!options.recordPath.empty())
+    {
+        recorder = new teh::utils::ReplayRecorder();
+        if (!recorder->open(options.recordPath))
+        {
+            return false;
+        }
+    }
+
     isRunning = true;
     lastTime = SDL_GetTicks();
+    fpsTime = lastTime;
+    telemetryLogTime = lastTime;
     
     TEH_GAME_LOG(INFO, "Game initialized successfully");
     return true;
@@ -55,28 +144,170 @@ bool Game::init()
 
 void Game::run()
 {
-    while (isRunning)
+    if (replayPlayer)
+    {
+        // Lockstep: one simulation step and one rendered frame per recorded frame, unthrottled
+        while (isRunning)
+        {
+            {
+                TEH_PROFILE_SCOPE(FRAME);
+
+                pumpEvents();
+                if (!isRunning || !simulate())
+                {
+                    break;
+                }
+                render();
+            }
+            teh::utils::Profiler::endFrame();
+        }
+    }
+    else
     {
-        // Calculate delta time
-        uint32_t currentTime = SDL_GetTicks();
-        uint32_t deltaTime = currentTime - lastTime;
-        lastTime = currentTime;
+        std::thread simulationThread(&Game::simulationLoop, this);
 
-        handleEvents();
-        update(deltaTime);
-        render(deltaTime);
+        while (isRunning)
+        {
+            pumpEvents();
+
+            bool rendered = false;
+            {
+                TEH_PROFILE_SCOPE(FRAME);
+                rendered = render();
+            }
+
+            if (rendered)
+            {
+                teh::utils::Profiler::endFrame();
+            }
+            else
+            {
+                // Nothing new to show yet, keep polling input
+                SDL_Delay(1);
+            }
+        }
+
+        simulationThread.join();
+    }
+
+    teh::utils::Profiler::report();
+}
+
+void Game::pumpEvents()
+{
+    SDL_Event e;
+
+    if (replayPlayer)
+    {
+        // Live input is ignored during a replay, except for closing the window
+        while (SDL_PollEvent(&e))
+        {
+            if (e.type == SDL_EVENT_QUIT)
+            {
+                TEH_GAME_LOG(INFO, "Replay interrupted at frame {}", replayPlayer->getFrameCount());
+                isRunning = false;
+            }
+        }
+        return;
+    }
 
-        // Small delay to avoid high CPU usage (~60 FPS)
+    std::lock_guard lock(eventMutex);
+    while (SDL_PollEvent(&e))
+    {
+        pendingEvents.push_back(e);
+    }
+}
+
+void Game::simulationLoop()
+{
+    while (isRunning)
+    {
+        simulate();
+
+        // Sleep to avoid high CPU usage (~60 simulation steps per second)
         SDL_Delay(16);
     }
 }
 
+bool Game::simulate()
+{
+    uint32_t deltaTime = 0;
+    if (!beginFrame(deltaTime))
+    {
+        return false;
+    }
+
+    handleEvents();
+    update(deltaTime);
+
+    state.time += deltaTime;
+    state.frame++;
+    snapshots.getWriteBuffer() = state;
+    snapshots.publish();
+    return true;
+}
+
+bool Game::beginFrame(uint32_t& deltaTime)
+{
+    TEH_PROFILE_SCOPE(EVENTS);
+
+    frameEvents.clear();
+
+    if (replayPlayer)
+    {
+        if (!replayPlayer->readFrame(deltaTime, frameEvents))
+        {
+            TEH_GAME_LOG(INFO, "Replay finished after {} frames", replayPlayer->getFrameCount());
+            return false;
+        }
+        return true;
+    }
+
+    // Calculate delta time
+    uint32_t currentTime = SDL_GetTicks();
+    deltaTime = currentTime - lastTime;
+    lastTime = currentTime;
+
+    {
+        std::lock_guard lock(eventMutex);
+        frameEvents.swap(pendingEvents);
+    }
+
+    if (recorder)
+    {
+        recorder->writeFrame(deltaTime, frameEvents);
+    }
+    return true;
+}
+
 void Game::cleanup()
 {
     TEH_GAME_LOG(INFO, "Cleaning up game resources...");
     
-    delete map;
-    map = nullptr;
+    if (recorder)
+    {
+        recorder->close();
+    }
+    delete recorder;
+    recorder = nullptr;
+
+    delete replayPlayer;
+    replayPlayer = nullptr;
+
+    delete debugOverlay;
+    debugOverlay = nullptr;
+
+    delete minimap;
+    minimap = nullptr;
+
+    delete world;
+    world = nullptr;
+
+    delete tileBackend;
+    tileBackend = nullptr;
+
+    delete textureCache;
+    textureCache = nullptr;
 
     if (renderer)
     {
@@ -96,8 +327,7 @@ void Game::cleanup()
 
 void Game::handleEvents()
 {
-    SDL_Event e;
-    while (SDL_PollEvent(&e))
+    for (const auto& e : frameEvents)
     {
         if (e.type == SDL_EVENT_QUIT)
         {
@@ -110,24 +340,136 @@ void Game::handleEvents()
                 TEH_INPUT_LOG(INFO, "Escape key pressed, exiting game");
                 isRunning = false;
             }
+            else if (e.key.key == SDLK_EQUALS || e.key.key == SDLK_KP_PLUS)
+            {
+                state.camera.zoomBy(2.0f);
+                TEH_INPUT_LOG(DEBUG, "Zoom: {}", state.camera.zoom);
+            }
+            else if (e.key.key == SDLK_MINUS || e.key.key == SDLK_KP_MINUS)
+            {
+                state.camera.zoomBy(0.5f);
+                TEH_INPUT_LOG(DEBUG, "Zoom: {}", state.camera.zoom);
+            }
+            else if (e.key.key == SDLK_LEFT)
+            {
+                state.camera.x -= CAMERA_PAN_STEP / state.camera.zoom;
+            }
+            else if (e.key.key == SDLK_RIGHT)
+            {
+                state.camera.x += CAMERA_PAN_STEP / state.camera.zoom;
+            }
+            else if (e.key.key == SDLK_UP)
+            {
+                state.camera.y -= CAMERA_PAN_STEP / state.camera.zoom;
+            }
+            else if (e.key.key == SDLK_DOWN)
+            {
+                state.camera.y += CAMERA_PAN_STEP / state.camera.zoom;
+            }
+            else if (e.key.key == SDLK_M)
+            {
+                state.minimapVisible = !state.minimapVisible;
+            }
+            else if (e.key.key == SDLK_L)
+            {
+                state.lightingEnabled = !state.lightingEnabled;
+                TEH_INPUT_LOG(DEBUG, "Lighting {}", state.lightingEnabled ? "enabled" : "disabled");
+            }
+            else if (e.key.key == SDLK_F3)
+            {
+                state.debugOverlayVisible = !state.debugOverlayVisible;
+            }
         }
     }
 }
 
 void Game::update(uint32_t deltaTime)
 {
+    TEH_PROFILE_SCOPE(UPDATE);
+
     // Game logic updates will go here
 }
 
-void Game::render(uint32_t deltaTime)
+bool Game::render()
 {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    if (!snapshots.update())
+    {
+        return false;
+    }
+
+    const RenderSnapshot& snapshot = snapshots.getReadBuffer();
+
+    // Animations advance by simulated time, including steps whose snapshots were skipped
+    uint32_t deltaTime = static_cast<uint32_t>(snapshot.time - renderedTime);
+    renderedTime = snapshot.time;
+
+    updateTelemetry(snapshot.debugOverlayVisible);
 
-    if (map)
     {
-        map->render(deltaTime);
+        TEH_PROFILE_SCOPE(RENDER);
+
+        // Uploads maps the loader finished and switches maps as the view crosses over, before the frame starts
+        if (world)
+        {
+            world->update(snapshot.camera);
+        }
+
+        tileBackend->beginFrame();
+
+        if (teh::map::Map* map = world ? world->getCurrentMap() : nullptr)
+        {
+            const teh::map::Camera mapCamera = world->toMapCamera(snapshot.camera);
+
+            map->getLighting().setEnabled(snapshot.lightingEnabled);
+            world->render(snapshot.camera, deltaTime);
+
+            if (minimap)
+            {
+                minimap->setVisible(snapshot.minimapVisible);
+                minimap->render(*map, mapCamera);
+            }
+        }
+
+        if (debugOverlay)
+        {
+            debugOverlay->setVisible(snapshot.debugOverlayVisible);
+            debugOverlay->render(mapStats, fps, tileBackend->getDrawCalls());
+        }
+    }
+
+    TEH_PROFILE_SCOPE(PRESENT);
+    tileBackend->endFrame();
+    return true;
+}
+
+void Game::updateTelemetry(bool overlayVisible)
+{
+    const uint64_t now = SDL_GetTicks();
+
+    fpsFrames++;
+    if (now - fpsTime >= TELEMETRY_REFRESH_MS)
+    {
+        fps = static_cast<float>(fpsFrames) * 1000.0f / static_cast<float>(now - fpsTime);
+        fpsFrames = 0;
+        fpsTime = now;
+    }
+
+    const teh::map::Map* map = world ? world->getCurrentMap() : nullptr;
+    if (!map)
+    {
+        return;
     }
 
-    SDL_RenderPresent(renderer);
+    // Map statistics walk every chunk and string, only refresh them while someone looks
+    if (debugOverlay && overlayVisible && now - statsTime >= TELEMETRY_REFRESH_MS)
+    {
+        mapStats = map->getStats();
+        statsTime = now;
+    }
+
+    if (teh::utils::Profiler::isEnabled() && now - telemetryLogTime >= TELEMETRY_LOG_MS)
+    {
+        map->getStats().log();
+        telemetryLogTime = now;
+    }
 }
@@ -2,28 +2,106 @@
 #define THEELDERWOODHILL_GAME_HPP
 
 #include <SDL3/SDL.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "Map/Map.hpp"
+#include "Map/World.hpp"
+#include "UI/DebugOverlay.hpp"
+#include "UI/Minimap.hpp"
+#include "Utils/Replay.hpp"
+#include "Utils/TextureCache.hpp"
+#include "Utils/TripleBuffer.hpp"
 
+/**
+ * @brief Command line controlled launch settings
+ */
+struct LaunchOptions
+{
+    std::string recordPath;     // Record input and frame timing to this file
+    std::string replayPath;     // Replay a recorded log instead of live input
+    bool headless = false;      // Hidden window, software rendering
+    bool profile = false;       // Collect frame-phase timings
+    bool gpu = false;           // Prefer the SDL_GPU tile backend
+    bool textureCache = true;   // Reuse decoded tilesets from the on-disk cache
+};
+
+/**
+ * @brief Immutable view of one simulation step, handed from the simulation to the renderer
+ */
+struct RenderSnapshot
+{
+    teh::map::Camera camera;
+    uint64_t time = 0;              // Simulation clock in milliseconds, drives tile animations
+    uint64_t frame = 0;             // Simulation step that produced the snapshot
+    bool minimapVisible = false;
+    bool lightingEnabled = false;
+    bool debugOverlayVisible = false;
+};
+
+/**
+ * @brief Owns the window and runs the main loop
+ *
+ * Live play runs the simulation on its own thread and publishes a RenderSnapshot
+ * per step; the main thread polls SDL events and renders the newest snapshot, so
+ * a slow present never stalls input handling or simulation. Replays run both in
+ * lockstep on the main thread to stay deterministic.
+ */
 class Game
 {
 public:
     Game();
     ~Game();
 
-    bool init();
+    bool init(const LaunchOptions& launchOptions = {});
     void run();
     void cleanup();
 
 private:
+    // Main thread
+    void pumpEvents();
+    bool render();
+    void updateTelemetry(bool overlayVisible);
+
+    // Simulation thread (main thread during replays)
+    void simulationLoop();
+    bool simulate();
+    bool beginFrame(uint32_t& deltaTime);
     void handleEvents();
     void update(uint32_t deltaTime);
-    void render(uint32_t deltaTime);
 
-    bool isRunning;
+    std::atomic<bool> isRunning;
     SDL_Window* window;
     SDL_Renderer* renderer;
-    teh::map::Map* map;
+    teh::map::TileBackend* tileBackend;
+    teh::utils::TextureCache* textureCache;
+    teh::map::World* world;
+    teh::ui::Minimap* minimap;
+    teh::ui::DebugOverlay* debugOverlay;
+    teh::utils::ReplayRecorder* recorder;
+    teh::utils::ReplayPlayer* replayPlayer;
+    LaunchOptions options;
+
+    // Events polled on the main thread, waiting for the next simulation step
+    std::mutex eventMutex;
+    std::vector<SDL_Event> pendingEvents;
+
+    // Simulation state, published into snapshots after every step
+    RenderSnapshot state;
+    std::vector<SDL_Event> frameEvents;
     uint32_t lastTime;
+
+    teh::utils::TripleBuffer<RenderSnapshot> snapshots;
+    uint64_t renderedTime;
+
+    // Render thread telemetry
+    teh::map::MapStats mapStats;
+    uint64_t statsTime;
+    uint64_t telemetryLogTime;
+    uint64_t fpsTime;
+    uint32_t fpsFrames;
+    float fps;
 };
 
 #endif //THEELDERWOODHILL_GAME_HPP
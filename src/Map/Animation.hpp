@@ -1,5 +1,6 @@
 #ifndef THEELDERWOODHILL_ANIMATION_HPP
 #define THEELDERWOODHILL_ANIMATION_HPP
+#include <cstddef>
 #include <cstdint>
 #include <ankerl/unordered_dense.h>
 
@@ -16,6 +17,7 @@ namespace teh::map
     public:
         void update(uint32_t deltaTime);
         AnimationState& getState(uint32_t tilesetIndex, uint32_t animationIndex);
+        size_t size() const { return m_States.size(); }
 
     private:
         ankerl::unordered_dense::map<uint64_t, AnimationState> m_States;
@@ -0,0 +1,125 @@
+#ifndef THEELDERWOODHILL_CAMERA_HPP
+#define THEELDERWOODHILL_CAMERA_HPP
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+
+namespace teh::map
+{
+    /**
+     * @brief View into the map, mapping world pixels to screen pixels
+     *
+     * screen = (world - position) * zoom
+     */
+    struct Camera
+    {
+        static constexpr float MIN_ZOOM = 1.0f / 32.0f;
+        static constexpr float MAX_ZOOM = 8.0f;
+
+        float x{};
+        float y{};
+        float zoom{1.0f};
+        float viewportWidth{};
+        float viewportHeight{};
+
+        /**
+         * @brief Get the visible area in world coordinates
+         */
+        SDL_FRect getWorldRect() const
+        {
+            return {x, y, viewportWidth / zoom, viewportHeight / zoom};
+        }
+
+        /**
+         * @brief Convert a world-space rect to screen space
+         */
+        SDL_FRect toScreen(const SDL_FRect& world) const
+        {
+            return {(world.x - x) * zoom, (world.y - y) * zoom, world.w * zoom, world.h * zoom};
+        }
+
+        /**
+         * @brief Multiply the zoom factor while keeping the viewport center fixed
+         */
+        void zoomBy(const float factor)
+        {
+            const float centerX = x + viewportWidth * 0.5f / zoom;
+            const float centerY = y + viewportHeight * 0.5f / zoom;
+            zoom = std::clamp(zoom * factor, MIN_ZOOM, MAX_ZOOM);
+            x = centerX - viewportWidth * 0.5f / zoom;
+            y = centerY - viewportHeight * 0.5f / zoom;
+        }
+
+        /**
+         * @brief Build a camera that maps a world rect onto a screen rect, preserving aspect ratio
+         */
+        static Camera fit(const SDL_FRect& world, const SDL_FRect& screen)
+        {
+            Camera camera;
+            if (world.w <= 0.0f || world.h <= 0.0f)
+            {
+                return camera;
+            }
+            camera.zoom = std::min(screen.w / world.w, screen.h / world.h);
+            camera.x = world.x - screen.x / camera.zoom;
+            camera.y = world.y - screen.y / camera.zoom;
+            camera.viewportWidth = screen.x + screen.w;
+            camera.viewportHeight = screen.y + screen.h;
+            return camera;
+        }
+    };
+
+    /**
+     * @brief Tiled layer offset and parallax factor
+     *
+     * A layer is drawn through its own camera, shifted by the offset and by (1 - parallax)
+     * times the view center, like Tiled with the parallax origin at 0,0. Tile coordinates
+     * of the layer stay untouched, so culling and caches work in layer space.
+     */
+    struct LayerTransform
+    {
+        float offsetX{};
+        float offsetY{};
+        float parallaxX{1.0f};
+        float parallaxY{1.0f};
+
+        bool operator==(const LayerTransform&) const = default;
+
+        bool hasParallax() const { return parallaxX != 1.0f || parallaxY != 1.0f; }
+
+        /**
+         * @brief Camera that sees the layer's tile coordinates
+         */
+        Camera apply(const Camera& camera) const
+        {
+            const float centerX = camera.x + camera.viewportWidth * 0.5f / camera.zoom;
+            const float centerY = camera.y + camera.viewportHeight * 0.5f / camera.zoom;
+
+            Camera layerCamera = camera;
+            layerCamera.x -= offsetX + centerX * (1.0f - parallaxX);
+            layerCamera.y -= offsetY + centerY * (1.0f - parallaxY);
+            return layerCamera;
+        }
+
+        /**
+         * @brief Like apply(), ignoring parallax (whole-map views such as the minimap)
+         */
+        Camera applyOffset(const Camera& camera) const
+        {
+            Camera layerCamera = camera;
+            layerCamera.x -= offsetX;
+            layerCamera.y -= offsetY;
+            return layerCamera;
+        }
+    };
+
+    /**
+     * @brief Check whether two rects overlap
+     */
+    inline bool intersects(const SDL_FRect& a, const SDL_FRect& b)
+    {
+        return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+}
+
+#endif //THEELDERWOODHILL_CAMERA_HPP
@@ -0,0 +1,441 @@
+#include "GpuTileBackend.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+// SPIR-V generated from shaders/tile.vert and shaders/tile.frag at build time
+#include "tile_vert_spv.h"
+#include "tile_frag_spv.h"
+
+namespace teh::map
+{
+    GpuTileBackend::GpuTileBackend(SDL_GPUDevice* device, SDL_Window* window, const bool headless)
+        : m_Device(device)
+          , m_Window(window)
+          , m_Headless(headless)
+          , m_Pipeline(nullptr)
+          , m_Sampler(nullptr)
+          , m_Offscreen(nullptr)
+          , m_InstanceBuffer(nullptr)
+          , m_InstanceTransfer(nullptr)
+          , m_InstanceCapacity(0)
+          , m_OffscreenWidth(0)
+          , m_OffscreenHeight(0)
+    {
+    }
+
+    GpuTileBackend::~GpuTileBackend()
+    {
+        if (m_InstanceTransfer)
+            SDL_ReleaseGPUTransferBuffer(m_Device, m_InstanceTransfer);
+        if (m_InstanceBuffer)
+            SDL_ReleaseGPUBuffer(m_Device, m_InstanceBuffer);
+        if (m_Offscreen)
+            SDL_ReleaseGPUTexture(m_Device, m_Offscreen);
+        if (m_Sampler)
+            SDL_ReleaseGPUSampler(m_Device, m_Sampler);
+        if (m_Pipeline)
+            SDL_ReleaseGPUGraphicsPipeline(m_Device, m_Pipeline);
+
+        if (!m_Headless)
+        {
+            SDL_ReleaseWindowFromGPUDevice(m_Device, m_Window);
+        }
+        SDL_DestroyGPUDevice(m_Device);
+    }
+
+    GpuTileBackend* GpuTileBackend::create(SDL_Window* window, const bool headless)
+    {
+        SDL_GPUDevice* device = SDL_CreateGPUDevice(SDL_GPU_SHADERFORMAT_SPIRV, false, nullptr);
+        if (!device)
+        {
+            TEH_GRAPHICS_LOG(WARN, "SDL_CreateGPUDevice Error: {}", SDL_GetError());
+            return nullptr;
+        }
+
+        if (!headless && !SDL_ClaimWindowForGPUDevice(device, window))
+        {
+            TEH_GRAPHICS_LOG(WARN, "SDL_ClaimWindowForGPUDevice Error: {}", SDL_GetError());
+            SDL_DestroyGPUDevice(device);
+            return nullptr;
+        }
+
+        auto* backend = new GpuTileBackend(device, window, headless);
+        if (!backend->createPipeline())
+        {
+            delete backend;
+            return nullptr;
+        }
+
+        TEH_GRAPHICS_LOG(INFO, "SDL_GPU tile backend ready (driver: {}{})",
+                         SDL_GetGPUDeviceDriver(device), headless ? ", offscreen" : "");
+        return backend;
+    }
+
+    bool GpuTileBackend::createPipeline()
+    {
+        SDL_GPUShaderCreateInfo vertexInfo{};
+        vertexInfo.code = TILE_VERT_SPV;
+        vertexInfo.code_size = sizeof(TILE_VERT_SPV);
+        vertexInfo.entrypoint = "main";
+        vertexInfo.format = SDL_GPU_SHADERFORMAT_SPIRV;
+        vertexInfo.stage = SDL_GPU_SHADERSTAGE_VERTEX;
+        vertexInfo.num_storage_buffers = 1;
+        vertexInfo.num_uniform_buffers = 1;
+
+        SDL_GPUShaderCreateInfo fragmentInfo{};
+        fragmentInfo.code = TILE_FRAG_SPV;
+        fragmentInfo.code_size = sizeof(TILE_FRAG_SPV);
+        fragmentInfo.entrypoint = "main";
+        fragmentInfo.format = SDL_GPU_SHADERFORMAT_SPIRV;
+        fragmentInfo.stage = SDL_GPU_SHADERSTAGE_FRAGMENT;
+        fragmentInfo.num_samplers = 1;
+
+        SDL_GPUShader* vertexShader = SDL_CreateGPUShader(m_Device, &vertexInfo);
+        SDL_GPUShader* fragmentShader = SDL_CreateGPUShader(m_Device, &fragmentInfo);
+        if (!vertexShader || !fragmentShader)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "Failed to create tile shaders: {}", SDL_GetError());
+            if (vertexShader)
+                SDL_ReleaseGPUShader(m_Device, vertexShader);
+            if (fragmentShader)
+                SDL_ReleaseGPUShader(m_Device, fragmentShader);
+            return false;
+        }
+
+        SDL_GPUTextureFormat targetFormat = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+        if (m_Headless)
+        {
+            int width = 0;
+            int height = 0;
+            SDL_GetWindowSizeInPixels(m_Window, &width, &height);
+            m_OffscreenWidth = static_cast<uint32_t>(std::max(width, 1));
+            m_OffscreenHeight = static_cast<uint32_t>(std::max(height, 1));
+
+            SDL_GPUTextureCreateInfo offscreenInfo{};
+            offscreenInfo.type = SDL_GPU_TEXTURETYPE_2D;
+            offscreenInfo.format = targetFormat;
+            offscreenInfo.usage = SDL_GPU_TEXTUREUSAGE_COLOR_TARGET;
+            offscreenInfo.width = m_OffscreenWidth;
+            offscreenInfo.height = m_OffscreenHeight;
+            offscreenInfo.layer_count_or_depth = 1;
+            offscreenInfo.num_levels = 1;
+            m_Offscreen = SDL_CreateGPUTexture(m_Device, &offscreenInfo);
+        }
+        else
+        {
+            targetFormat = SDL_GetGPUSwapchainTextureFormat(m_Device, m_Window);
+        }
+
+        SDL_GPUColorTargetDescription colorTarget{};
+        colorTarget.format = targetFormat;
+        colorTarget.blend_state.enable_blend = true;
+        colorTarget.blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE;     // Premultiplied tilesets
+        colorTarget.blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTarget.blend_state.color_blend_op = SDL_GPU_BLENDOP_ADD;
+        colorTarget.blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+        colorTarget.blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTarget.blend_state.alpha_blend_op = SDL_GPU_BLENDOP_ADD;
+
+        // Quads are generated from gl_VertexIndex, so there is no vertex input
+        SDL_GPUGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.vertex_shader = vertexShader;
+        pipelineInfo.fragment_shader = fragmentShader;
+        pipelineInfo.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        pipelineInfo.rasterizer_state.fill_mode = SDL_GPU_FILLMODE_FILL;
+        pipelineInfo.rasterizer_state.cull_mode = SDL_GPU_CULLMODE_NONE;
+        pipelineInfo.target_info.color_target_descriptions = &colorTarget;
+        pipelineInfo.target_info.num_color_targets = 1;
+
+        m_Pipeline = SDL_CreateGPUGraphicsPipeline(m_Device, &pipelineInfo);
+        SDL_ReleaseGPUShader(m_Device, vertexShader);
+        SDL_ReleaseGPUShader(m_Device, fragmentShader);
+
+        SDL_GPUSamplerCreateInfo samplerInfo{};
+        samplerInfo.min_filter = SDL_GPU_FILTER_NEAREST;
+        samplerInfo.mag_filter = SDL_GPU_FILTER_NEAREST;
+        samplerInfo.mipmap_mode = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST;
+        samplerInfo.address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+        samplerInfo.address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+        samplerInfo.address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+        m_Sampler = SDL_CreateGPUSampler(m_Device, &samplerInfo);
+
+        if (!m_Pipeline || !m_Sampler || (m_Headless && !m_Offscreen))
+        {
+            TEH_GRAPHICS_LOG(ERROR, "Failed to create tile pipeline: {}", SDL_GetError());
+            return false;
+        }
+        return true;
+    }
+
+    GpuTilesetSet::~GpuTilesetSet()
+    {
+        // Released once the GPU is done with any frame still sampling it
+        if (m_Atlas)
+        {
+            SDL_ReleaseGPUTexture(m_Device, m_Atlas);
+        }
+    }
+
+    void GpuTilesetSet::getStats(std::vector<TextureStats>& stats) const
+    {
+        // Every array layer is padded to the largest tileset
+        for (const auto& name : m_Names)
+        {
+            stats.push_back({name, static_cast<int>(m_AtlasWidth), static_cast<int>(m_AtlasHeight), 4});
+        }
+    }
+
+    size_t GpuTileBackend::getTilesetBytes(const TilesetImages& images) const
+    {
+        // Matches createTilesets(): one array layer per tileset, each padded to the largest one
+        size_t width = 0;
+        size_t height = 0;
+        for (const auto& image : images)
+        {
+            width = std::max(width, static_cast<size_t>(image.getWidth()));
+            height = std::max(height, static_cast<size_t>(image.getHeight()));
+        }
+        return width * height * 4 * images.size();
+    }
+
+    TilesetSet* GpuTileBackend::createTilesets(const tmx::render::MapRenderData& renderData, const TilesetImages& images)
+    {
+        if (images.size() != renderData.tilesets.size())
+        {
+            return nullptr;
+        }
+
+        auto* tilesets = new GpuTilesetSet(m_Device);
+        bool success = true;
+
+        for (size_t i = 0; i < renderData.tilesets.size(); ++i)
+        {
+            const auto& tileset = renderData.tilesets[i];
+
+            TEH_MAP_LOG(DEBUG, "Uploading tileset {}: '{}' from {}", i, tileset.name, tileset.imagePath);
+
+            tilesets->m_AtlasWidth = std::max(tilesets->m_AtlasWidth, static_cast<uint32_t>(images[i].getWidth()));
+            tilesets->m_AtlasHeight = std::max(tilesets->m_AtlasHeight, static_cast<uint32_t>(images[i].getHeight()));
+            tilesets->m_Names.push_back(tileset.name);
+        }
+
+        if (!images.empty())
+        {
+            // Every tileset gets one layer of a shared array texture, anchored at the top-left corner
+            SDL_GPUTextureCreateInfo atlasInfo{};
+            atlasInfo.type = SDL_GPU_TEXTURETYPE_2D_ARRAY;
+            atlasInfo.format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+            atlasInfo.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER;
+            atlasInfo.width = tilesets->m_AtlasWidth;
+            atlasInfo.height = tilesets->m_AtlasHeight;
+            atlasInfo.layer_count_or_depth = static_cast<uint32_t>(images.size());
+            atlasInfo.num_levels = 1;
+            tilesets->m_Atlas = SDL_CreateGPUTexture(m_Device, &atlasInfo);
+
+            uint32_t uploadSize = 0;
+            for (const auto& image : images)
+            {
+                uploadSize += static_cast<uint32_t>(image.getWidth() * image.getHeight() * 4);
+            }
+
+            SDL_GPUTransferBufferCreateInfo transferInfo{};
+            transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            transferInfo.size = uploadSize;
+            SDL_GPUTransferBuffer* transfer = tilesets->m_Atlas ? SDL_CreateGPUTransferBuffer(m_Device, &transferInfo) : nullptr;
+
+            if (!transfer)
+            {
+                TEH_GRAPHICS_LOG(ERROR, "Failed to create tileset atlas: {}", SDL_GetError());
+                success = false;
+            }
+            else
+            {
+                // Cached images are copied straight from their mapped pages
+                auto* mapped = static_cast<uint8_t*>(SDL_MapGPUTransferBuffer(m_Device, transfer, false));
+                uint32_t offset = 0;
+                for (const auto& image : images)
+                {
+                    const size_t rowBytes = static_cast<size_t>(image.getWidth()) * 4;
+                    for (int y = 0; y < image.getHeight(); ++y)
+                    {
+                        std::memcpy(mapped + offset + y * rowBytes,
+                                    static_cast<const uint8_t*>(image.getPixels()) + y * image.getPitch(),
+                                    rowBytes);
+                    }
+                    offset += static_cast<uint32_t>(rowBytes * image.getHeight());
+                }
+                SDL_UnmapGPUTransferBuffer(m_Device, transfer);
+
+                SDL_GPUCommandBuffer* commands = SDL_AcquireGPUCommandBuffer(m_Device);
+                SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commands);
+                offset = 0;
+                for (uint32_t layer = 0; layer < images.size(); ++layer)
+                {
+                    const auto& image = images[layer];
+
+                    SDL_GPUTextureTransferInfo source{};
+                    source.transfer_buffer = transfer;
+                    source.offset = offset;
+                    source.pixels_per_row = static_cast<uint32_t>(image.getWidth());
+                    source.rows_per_layer = static_cast<uint32_t>(image.getHeight());
+
+                    SDL_GPUTextureRegion destination{};
+                    destination.texture = tilesets->m_Atlas;
+                    destination.layer = layer;
+                    destination.w = static_cast<uint32_t>(image.getWidth());
+                    destination.h = static_cast<uint32_t>(image.getHeight());
+                    destination.d = 1;
+
+                    SDL_UploadToGPUTexture(copyPass, &source, &destination, false);
+                    offset += static_cast<uint32_t>(image.getWidth() * image.getHeight() * 4);
+                }
+                SDL_EndGPUCopyPass(copyPass);
+                SDL_SubmitGPUCommandBuffer(commands);
+                SDL_ReleaseGPUTransferBuffer(m_Device, transfer);
+
+                TEH_RESOURCE_LOG(DEBUG, "Tileset atlas uploaded: {}x{} x {} layers", tilesets->m_AtlasWidth, tilesets->m_AtlasHeight, images.size());
+            }
+        }
+
+        if (!success)
+        {
+            delete tilesets;
+            return nullptr;
+        }
+        return tilesets;
+    }
+
+    bool GpuTileBackend::ensureInstanceCapacity(const uint32_t count)
+    {
+        if (count <= m_InstanceCapacity)
+        {
+            return true;
+        }
+
+        uint32_t capacity = std::max(m_InstanceCapacity, 1024u);
+        while (capacity < count)
+        {
+            capacity *= 2;
+        }
+
+        if (m_InstanceBuffer)
+            SDL_ReleaseGPUBuffer(m_Device, m_InstanceBuffer);
+        if (m_InstanceTransfer)
+            SDL_ReleaseGPUTransferBuffer(m_Device, m_InstanceTransfer);
+
+        const auto size = static_cast<uint32_t>(capacity * sizeof(TileInstance));
+
+        SDL_GPUBufferCreateInfo bufferInfo{};
+        bufferInfo.usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+        bufferInfo.size = size;
+        m_InstanceBuffer = SDL_CreateGPUBuffer(m_Device, &bufferInfo);
+
+        SDL_GPUTransferBufferCreateInfo transferInfo{};
+        transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        transferInfo.size = size;
+        m_InstanceTransfer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+
+        if (!m_InstanceBuffer || !m_InstanceTransfer)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "Failed to grow instance buffer to {} tiles: {}", capacity, SDL_GetError());
+            m_InstanceCapacity = 0;
+            return false;
+        }
+
+        m_InstanceCapacity = capacity;
+        return true;
+    }
+
+    void GpuTileBackend::beginFrame()
+    {
+        resetDrawCalls();
+        m_FrameInstances.clear();
+    }
+
+    void GpuTileBackend::drawTiles(std::span<const TileInstance> tiles, uint32_t)
+    {
+        // The shader reads flips and opacity per instance; batches only keep their order
+        m_FrameInstances.insert(m_FrameInstances.end(), tiles.begin(), tiles.end());
+    }
+
+    void GpuTileBackend::endFrame()
+    {
+        SDL_GPUCommandBuffer* commands = SDL_AcquireGPUCommandBuffer(m_Device);
+        if (!commands)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "SDL_AcquireGPUCommandBuffer Error: {}", SDL_GetError());
+            return;
+        }
+
+        const auto* tilesets = static_cast<const GpuTilesetSet*>(m_Tilesets);
+        const auto count = static_cast<uint32_t>(m_FrameInstances.size());
+        const bool hasInstances = count > 0 && tilesets && tilesets->m_Atlas && ensureInstanceCapacity(count);
+
+        if (hasInstances)
+        {
+            void* mapped = SDL_MapGPUTransferBuffer(m_Device, m_InstanceTransfer, true);
+            std::memcpy(mapped, m_FrameInstances.data(), count * sizeof(TileInstance));
+            SDL_UnmapGPUTransferBuffer(m_Device, m_InstanceTransfer);
+
+            SDL_GPUTransferBufferLocation source{m_InstanceTransfer, 0};
+            SDL_GPUBufferRegion destination{m_InstanceBuffer, 0, static_cast<uint32_t>(count * sizeof(TileInstance))};
+
+            SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commands);
+            SDL_UploadToGPUBuffer(copyPass, &source, &destination, true);
+            SDL_EndGPUCopyPass(copyPass);
+        }
+
+        SDL_GPUTexture* target = m_Offscreen;
+        uint32_t width = m_OffscreenWidth;
+        uint32_t height = m_OffscreenHeight;
+        if (!m_Headless && !SDL_WaitAndAcquireGPUSwapchainTexture(commands, m_Window, &target, &width, &height))
+        {
+            TEH_GRAPHICS_LOG(ERROR, "SDL_WaitAndAcquireGPUSwapchainTexture Error: {}", SDL_GetError());
+            target = nullptr;
+        }
+
+        // A null swapchain texture means the window is minimized; skip drawing but still submit
+        if (target)
+        {
+            SDL_GPUColorTargetInfo colorTarget{};
+            colorTarget.texture = target;
+            colorTarget.clear_color = {0.0f, 0.0f, 0.0f, 1.0f};
+            colorTarget.load_op = SDL_GPU_LOADOP_CLEAR;
+            colorTarget.store_op = SDL_GPU_STOREOP_STORE;
+
+            SDL_GPURenderPass* pass = SDL_BeginGPURenderPass(commands, &colorTarget, 1, nullptr);
+            if (hasInstances)
+            {
+                const FrameUniforms uniforms = {
+                    static_cast<float>(width),
+                    static_cast<float>(height),
+                    static_cast<float>(tilesets->m_AtlasWidth),
+                    static_cast<float>(tilesets->m_AtlasHeight)
+                };
+                const SDL_GPUTextureSamplerBinding atlasBinding{tilesets->m_Atlas, m_Sampler};
+
+                SDL_BindGPUGraphicsPipeline(pass, m_Pipeline);
+                SDL_BindGPUVertexStorageBuffers(pass, 0, &m_InstanceBuffer, 1);
+                SDL_BindGPUFragmentSamplers(pass, 0, &atlasBinding, 1);
+                SDL_PushGPUVertexUniformData(commands, 0, &uniforms, sizeof(uniforms));
+                SDL_DrawGPUPrimitives(pass, 6, count, 0, 0);
+                m_DrawCalls++;
+            }
+            SDL_EndGPURenderPass(pass);
+        }
+
+        SDL_SubmitGPUCommandBuffer(commands);
+    }
+
+    void GpuTileBackend::getOutputSize(int& width, int& height) const
+    {
+        if (m_Headless)
+        {
+            width = static_cast<int>(m_OffscreenWidth);
+            height = static_cast<int>(m_OffscreenHeight);
+            return;
+        }
+        SDL_GetWindowSizeInPixels(m_Window, &width, &height);
+    }
+}
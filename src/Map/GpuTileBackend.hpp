@@ -0,0 +1,99 @@
+#ifndef THEELDERWOODHILL_GPUTILEBACKEND_HPP
+#define THEELDERWOODHILL_GPUTILEBACKEND_HPP
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+#include "TileBackend.hpp"
+
+namespace teh::map
+{
+    /**
+     * @brief Tilesets of one map as layers of a 2D array texture
+     */
+    class GpuTilesetSet : public TilesetSet
+    {
+    public:
+        ~GpuTilesetSet() override;
+
+        void getStats(std::vector<TextureStats>& stats) const override;
+
+    private:
+        friend class GpuTileBackend;
+
+        explicit GpuTilesetSet(SDL_GPUDevice* device) : m_Device(device) {}
+
+        SDL_GPUDevice* m_Device;
+        SDL_GPUTexture* m_Atlas{};
+        uint32_t m_AtlasWidth{};
+        uint32_t m_AtlasHeight{};
+        std::vector<std::string> m_Names;
+    };
+
+    /**
+     * @brief Tile backend on the SDL_GPU API
+     *
+     * All tilesets of a map live in one 2D array texture. Each frame's instances are
+     * uploaded to a storage buffer and drawn with a single instanced call.
+     * Headless mode renders into an offscreen target instead of a swapchain,
+     * so the backend runs on software Vulkan drivers (lavapipe) without a display.
+     */
+    class GpuTileBackend : public TileBackend
+    {
+    public:
+        ~GpuTileBackend() override;
+
+        GpuTileBackend(const GpuTileBackend&) = delete;
+        GpuTileBackend& operator=(const GpuTileBackend&) = delete;
+
+        /**
+         * @brief Create a GPU device and the tile pipeline
+         * @param window Window to present to
+         * @param headless Render offscreen instead of claiming the window
+         * @return The backend, or nullptr if SDL_GPU is unavailable
+         */
+        static GpuTileBackend* create(SDL_Window* window, bool headless);
+
+        const char* getName() const override { return "SDL_GPU"; }
+
+        TilesetSet* createTilesets(const tmx::render::MapRenderData& renderData, const TilesetImages& images) override;
+        size_t getTilesetBytes(const TilesetImages& images) const override;
+
+        void beginFrame() override;
+        void drawTiles(std::span<const TileInstance> tiles, uint32_t variant) override;
+        void endFrame() override;
+
+        void getOutputSize(int& width, int& height) const override;
+
+    private:
+        // Per-frame vertex uniforms, std140
+        struct FrameUniforms
+        {
+            float viewportWidth;
+            float viewportHeight;
+            float atlasWidth;
+            float atlasHeight;
+        };
+
+        GpuTileBackend(SDL_GPUDevice* device, SDL_Window* window, bool headless);
+
+        bool createPipeline();
+        bool ensureInstanceCapacity(uint32_t count);
+
+        SDL_GPUDevice* m_Device;
+        SDL_Window* m_Window;
+        bool m_Headless;
+
+        SDL_GPUGraphicsPipeline* m_Pipeline;
+        SDL_GPUSampler* m_Sampler;
+        SDL_GPUTexture* m_Offscreen;
+        SDL_GPUBuffer* m_InstanceBuffer;
+        SDL_GPUTransferBuffer* m_InstanceTransfer;
+        uint32_t m_InstanceCapacity;
+        uint32_t m_OffscreenWidth;
+        uint32_t m_OffscreenHeight;
+
+        std::vector<TileInstance> m_FrameInstances;
+    };
+}
+
+#endif //THEELDERWOODHILL_GPUTILEBACKEND_HPP
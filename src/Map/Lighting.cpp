@@ -0,0 +1,282 @@
+#include "Lighting.hpp"
+#include "Telemetry.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+namespace teh::map
+{
+    namespace
+    {
+        constexpr std::string_view LIGHTS_LAYER_NAME = "Lights";
+        constexpr std::string_view FIRE_TILESET_PREFIX = "fire";
+
+        // Light radius in tiles
+        constexpr float LIGHTS_LAYER_RADIUS = 3.0f;
+        constexpr float FIRE_RADIUS = 4.0f;
+
+        constexpr SDL_FColor LIGHTS_LAYER_COLOR = {1.0f, 0.9f, 0.7f, 1.0f};
+        constexpr SDL_FColor FIRE_COLOR = {1.0f, 0.65f, 0.35f, 1.0f};
+        constexpr SDL_FColor DEFAULT_AMBIENT = {0.35f, 0.35f, 0.45f, 1.0f};
+
+        bool isFireTileset(const std::string& name)
+        {
+            return std::string_view(name).starts_with(FIRE_TILESET_PREFIX);
+        }
+    }
+
+    Lighting::Lighting(SDL_Renderer* sdlRenderer)
+        : m_SdlRenderer(sdlRenderer)
+          , m_Gradient(nullptr)
+          , m_Buffer(nullptr)
+          , m_BufferWidth(0)
+          , m_BufferHeight(0)
+          , m_Ambient(DEFAULT_AMBIENT)
+          , m_Enabled(true)
+    {
+    }
+
+    Lighting::~Lighting()
+    {
+        if (m_Gradient)
+        {
+            SDL_DestroyTexture(m_Gradient);
+        }
+        if (m_Buffer)
+        {
+            SDL_DestroyTexture(m_Buffer);
+        }
+    }
+
+    bool Lighting::build(const tmx::render::MapRenderData& renderData,
+                         const std::vector<LayerTransform>& transforms)
+    {
+        m_Lights.clear();
+
+        if (renderData.mapWidth == 0 || renderData.mapHeight == 0)
+        {
+            return true;
+        }
+
+        const float tileW = static_cast<float>(renderData.pixelWidth) / renderData.mapWidth;
+        const float tileH = static_cast<float>(renderData.pixelHeight) / renderData.mapHeight;
+
+        // A torch usually appears on several layers (flame sprite plus glow); keep one light per cell
+        ankerl::unordered_dense::map<uint64_t, size_t> lightsByCell;
+
+        for (size_t layerIndex = 0; layerIndex < renderData.layers.size(); ++layerIndex)
+        {
+            const auto& layer = renderData.layers[layerIndex];
+            if (!layer.visible)
+                continue;
+
+            // Lights live in map space: offsets apply, parallax does not
+            const LayerTransform transform = layerIndex < transforms.size() ? transforms[layerIndex] : LayerTransform{};
+            const bool isLightsLayer = layer.name == LIGHTS_LAYER_NAME;
+
+            for (const auto& tile : layer.tiles)
+            {
+                if (tile.tilesetIndex >= renderData.tilesets.size())
+                {
+                    continue;
+                }
+
+                const bool isFire = isFireTileset(renderData.tilesets[tile.tilesetIndex].name);
+                if (!isLightsLayer && !isFire)
+                {
+                    continue;
+                }
+
+                Light light;
+                light.x = static_cast<float>(tile.destX) + static_cast<float>(tile.destW) * 0.5f + transform.offsetX;
+                light.y = static_cast<float>(tile.destY) + static_cast<float>(tile.destH) * 0.5f + transform.offsetY;
+                light.radius = (isFire ? FIRE_RADIUS : LIGHTS_LAYER_RADIUS) * std::max(tileW, tileH);
+                light.color = isFire ? FIRE_COLOR : LIGHTS_LAYER_COLOR;
+                if (isFire && tile.isAnimated)
+                {
+                    light.tilesetIndex = tile.tilesetIndex;
+                    light.animationIndex = tile.animationIndex;
+                }
+
+                const auto cellX = static_cast<int32_t>(std::floor(light.x / tileW));
+                const auto cellY = static_cast<int32_t>(std::floor(light.y / tileH));
+                const uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32 | static_cast<uint32_t>(cellY);
+
+                auto [it, inserted] = lightsByCell.try_emplace(key, m_Lights.size());
+                if (inserted)
+                {
+                    light.seed = static_cast<uint32_t>(key * 2654435761u);
+                    m_Lights.push_back(light);
+                    continue;
+                }
+
+                // Fire wins over the plain glow so the merged light flickers
+                auto& existing = m_Lights[it->second];
+                if (isFire)
+                {
+                    existing.color = light.color;
+                    existing.tilesetIndex = light.tilesetIndex;
+                    existing.animationIndex = light.animationIndex;
+                }
+                existing.radius = std::max(existing.radius, light.radius);
+            }
+        }
+
+        TEH_MAP_LOG(DEBUG, "Extracted {} lights", m_Lights.size());
+
+        if (m_Lights.empty() || m_Gradient)
+        {
+            return true;
+        }
+
+        // Radial falloff used as the brush for every light
+        std::vector<uint8_t> pixels(GRADIENT_SIZE * GRADIENT_SIZE * 4);
+        const float half = GRADIENT_SIZE * 0.5f;
+        for (int y = 0; y < GRADIENT_SIZE; ++y)
+        {
+            for (int x = 0; x < GRADIENT_SIZE; ++x)
+            {
+                const float dx = (static_cast<float>(x) + 0.5f - half) / half;
+                const float dy = (static_cast<float>(y) + 0.5f - half) / half;
+                const float falloff = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy));
+                const auto value = static_cast<uint8_t>(falloff * falloff * 255.0f);
+
+                uint8_t* pixel = &pixels[(y * GRADIENT_SIZE + x) * 4];
+                pixel[0] = value;
+                pixel[1] = value;
+                pixel[2] = value;
+                pixel[3] = 255;
+            }
+        }
+
+        m_Gradient = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                       GRADIENT_SIZE, GRADIENT_SIZE);
+        if (!m_Gradient)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "Failed to create light gradient texture: {}", SDL_GetError());
+            return false;
+        }
+        SDL_UpdateTexture(m_Gradient, nullptr, pixels.data(), GRADIENT_SIZE * 4);
+        SDL_SetTextureBlendMode(m_Gradient, SDL_BLENDMODE_ADD);
+        SDL_SetTextureScaleMode(m_Gradient, SDL_SCALEMODE_LINEAR);
+        return true;
+    }
+
+    bool Lighting::ensureBuffer(const int width, const int height)
+    {
+        if (m_Buffer && m_BufferWidth == width && m_BufferHeight == height)
+        {
+            return true;
+        }
+
+        if (m_Buffer)
+        {
+            SDL_DestroyTexture(m_Buffer);
+        }
+
+        m_Buffer = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!m_Buffer)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "Failed to create light buffer: {}", SDL_GetError());
+            m_BufferWidth = 0;
+            m_BufferHeight = 0;
+            return false;
+        }
+
+        SDL_SetTextureBlendMode(m_Buffer, SDL_BLENDMODE_MOD);
+        SDL_SetTextureScaleMode(m_Buffer, SDL_SCALEMODE_LINEAR);
+        m_BufferWidth = width;
+        m_BufferHeight = height;
+        return true;
+    }
+
+    float Lighting::flicker(const Light& light,
+                            const tmx::render::MapRenderData& renderData,
+                            AnimationStateManager& animationStates)
+    {
+        if (light.animationIndex == static_cast<uint32_t>(-1) || light.tilesetIndex >= renderData.tilesets.size())
+        {
+            return 1.0f;
+        }
+
+        const auto& animations = renderData.tilesets[light.tilesetIndex].animations;
+        if (light.animationIndex >= animations.size() || animations[light.animationIndex].totalDuration == 0)
+        {
+            return 1.0f;
+        }
+
+        // Brightness steps with the flame's own frame, so the glow changes exactly when the sprite does
+        const auto& animation = animations[light.animationIndex];
+        const auto& state = animationStates.getState(light.tilesetIndex, light.animationIndex);
+        const uint32_t frameIndex = animation.getFrameIndexAtTime(state.elapsedTime % animation.totalDuration);
+
+        uint32_t hash = (frameIndex + 1) * 2654435761u ^ light.seed;
+        hash ^= hash >> 15;
+        hash *= 2246822519u;
+        hash ^= hash >> 13;
+        return 0.8f + 0.2f * static_cast<float>(hash & 0xFFFF) / 65535.0f;
+    }
+
+    uint32_t Lighting::render(const tmx::render::MapRenderData& renderData,
+                              AnimationStateManager& animationStates,
+                              const Camera& camera)
+    {
+        if (!m_Enabled || m_Lights.empty() || !m_Gradient)
+        {
+            return 0;
+        }
+
+        const int width = std::max(1, static_cast<int>(std::ceil(camera.viewportWidth / BUFFER_DOWNSCALE)));
+        const int height = std::max(1, static_cast<int>(std::ceil(camera.viewportHeight / BUFFER_DOWNSCALE)));
+        if (!ensureBuffer(width, height))
+        {
+            return 0;
+        }
+
+        uint32_t drawn = 0;
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(m_SdlRenderer);
+        SDL_SetRenderTarget(m_SdlRenderer, m_Buffer);
+        SDL_SetRenderDrawColorFloat(m_SdlRenderer, m_Ambient.r, m_Ambient.g, m_Ambient.b, 1.0f);
+        SDL_RenderClear(m_SdlRenderer);
+
+        const SDL_FRect view = camera.getWorldRect();
+        constexpr float scale = 1.0f / BUFFER_DOWNSCALE;
+
+        for (const auto& light : m_Lights)
+        {
+            const SDL_FRect worldRect = {light.x - light.radius, light.y - light.radius, light.radius * 2.0f, light.radius * 2.0f};
+            if (!intersects(worldRect, view))
+            {
+                continue;
+            }
+
+            const float intensity = flicker(light, renderData, animationStates);
+            SDL_SetTextureColorModFloat(m_Gradient, light.color.r * intensity, light.color.g * intensity, light.color.b * intensity);
+
+            const SDL_FRect screenRect = camera.toScreen(worldRect);
+            const SDL_FRect destRect = {screenRect.x * scale, screenRect.y * scale, screenRect.w * scale, screenRect.h * scale};
+            SDL_RenderTexture(m_SdlRenderer, m_Gradient, nullptr, &destRect);
+            drawn++;
+        }
+
+        SDL_SetRenderTarget(m_SdlRenderer, previousTarget);
+
+        // Multiply the accumulated light over the scene
+        const SDL_FRect screen = {0.0f, 0.0f, camera.viewportWidth, camera.viewportHeight};
+        SDL_RenderTexture(m_SdlRenderer, m_Buffer, nullptr, &screen);
+        return drawn + 1;
+    }
+
+    size_t Lighting::getTextureBytes() const
+    {
+        return TextureStats::fromTexture({}, m_Gradient).getBytes() + TextureStats::fromTexture({}, m_Buffer).getBytes();
+    }
+
+    size_t Lighting::estimateTextureBytes(const int viewportWidth, const int viewportHeight)
+    {
+        const auto width = static_cast<size_t>(std::max(1, (viewportWidth + BUFFER_DOWNSCALE - 1) / BUFFER_DOWNSCALE));
+        const auto height = static_cast<size_t>(std::max(1, (viewportHeight + BUFFER_DOWNSCALE - 1) / BUFFER_DOWNSCALE));
+        return static_cast<size_t>(GRADIENT_SIZE) * GRADIENT_SIZE * 4 + width * height * 4;
+    }
+}
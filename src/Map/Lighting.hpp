@@ -0,0 +1,104 @@
+#ifndef THEELDERWOODHILL_LIGHTING_HPP
+#define THEELDERWOODHILL_LIGHTING_HPP
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include <tmx/tmx.hpp>
+#include "Animation.hpp"
+#include "Camera.hpp"
+
+namespace teh::map
+{
+    /**
+     * @brief Point light extracted from the map at load time
+     */
+    struct Light
+    {
+        float x{};
+        float y{};
+        float radius{};
+        SDL_FColor color{};
+        uint32_t tilesetIndex{};
+        uint32_t animationIndex{static_cast<uint32_t>(-1)};
+        uint32_t seed{};
+    };
+
+    /**
+     * @brief Lightmap pass: accumulates lights into a low-resolution buffer and multiplies it over the scene
+     *
+     * Light sources are tiles on the "Lights" layer and fire tilesets. Per-frame cost
+     * scales with the number of visible lights, not with the number of tiles.
+     */
+    class Lighting
+    {
+    public:
+        static constexpr int BUFFER_DOWNSCALE = 4;
+        static constexpr int GRADIENT_SIZE = 64;
+
+        explicit Lighting(SDL_Renderer* sdlRenderer);
+        ~Lighting();
+
+        Lighting(const Lighting&) = delete;
+        Lighting& operator=(const Lighting&) = delete;
+
+        /**
+         * @brief Collect light sources from the render data
+         * @param renderData Pre-calculated render data from tmxparser
+         * @param transforms Offset and parallax per render layer, identity if empty
+         * @return true if the light resources were created
+         */
+        bool build(const tmx::render::MapRenderData& renderData,
+                   const std::vector<LayerTransform>& transforms = {});
+
+        /**
+         * @brief Render the lightmap over whatever is currently in the target
+         * @param renderData Render data providing the fire animations
+         * @param animationStates Animation clocks driving light flicker
+         * @param camera View used to cull and place lights
+         * @return Number of textures drawn
+         */
+        uint32_t render(const tmx::render::MapRenderData& renderData,
+                    AnimationStateManager& animationStates,
+                    const Camera& camera);
+
+        void setAmbient(const SDL_FColor& ambient) { m_Ambient = ambient; }
+        void setEnabled(bool enabled) { m_Enabled = enabled; }
+        bool isEnabled() const { return m_Enabled; }
+
+        const std::vector<Light>& getLights() const { return m_Lights; }
+
+        /**
+         * @brief Size of the gradient and light buffer textures
+         */
+        size_t getTextureBytes() const;
+
+        /**
+         * @brief Size getTextureBytes() reaches once lights were drawn into a viewport
+         */
+        static size_t estimateTextureBytes(int viewportWidth, int viewportHeight);
+
+    private:
+        /**
+         * @brief (Re)create the light buffer to match the viewport
+         */
+        bool ensureBuffer(int width, int height);
+
+        /**
+         * @brief Brightness multiplier for a light this frame
+         */
+        static float flicker(const Light& light,
+                             const tmx::render::MapRenderData& renderData,
+                             AnimationStateManager& animationStates);
+
+        SDL_Renderer* m_SdlRenderer;
+        SDL_Texture* m_Gradient;
+        SDL_Texture* m_Buffer;
+        int m_BufferWidth;
+        int m_BufferHeight;
+        std::vector<Light> m_Lights;
+        SDL_FColor m_Ambient;
+        bool m_Enabled;
+    };
+}
+
+#endif //THEELDERWOODHILL_LIGHTING_HPP
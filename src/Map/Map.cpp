@@ -1,15 +1,19 @@
 #include "Map.hpp"
 #include "../Utils/Logger.hpp"
-#include <SDL3_image/SDL_image.h>
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
 
 namespace fs = std::filesystem;
 
 namespace teh::map
 {
-    Map::Map(SDL_Renderer* renderer)         : m_Renderer(renderer)
-          , m_MapRenderer(renderer)
+    Map::Map(TileBackend& backend)         : m_Backend(backend)
+          , m_MapRenderer(backend)
+          , m_Overview(backend.getSdlRenderer())
+          , m_Lighting(backend.getSdlRenderer())
+          , m_Tilesets(nullptr)
+          , m_Prepared(false)
           , m_Loaded(false)
     {
     }
@@ -17,17 +21,19 @@ namespace teh::map
     Map::~Map()
     {
         // Clean up all tileset textures
-        for (auto* texture : m_TilesetTextures)
+        if (m_Backend.getBoundTilesets() == m_Tilesets)
         {
-            if (texture)
-            {
-                SDL_DestroyTexture(texture);
-            }
+            m_Backend.bindTilesets(nullptr);
         }
-        m_TilesetTextures.clear();
+        delete m_Tilesets;
     }
 
     bool Map::load(const std::string& filePath)
+    {
+        return prepare(filePath) && finalize();
+    }
+
+    bool Map::prepare(const std::string& filePath)
     {
         TEH_MAP_LOG(INFO, "Starting to load map: {}", filePath);
 
@@ -70,10 +76,40 @@ namespace teh::map
         }
         TEH_MAP_LOG(DEBUG, "Total animations: {}", totalAnimations);
 
+        // Render layers don't carry offset and parallax, take them from the parsed layers.
+        // Both lists are in document order, so match positionally and only skip parsed layers
+        // the render data left out; a name lookup would pick the wrong one of two same-named layers.
+        auto& transforms = m_Transforms;
+        transforms.assign(m_RenderData.layers.size(), {});
+        auto next = map.layers.begin();
+        for (size_t i = 0; i < m_RenderData.layers.size(); ++i)
+        {
+            const auto& name = m_RenderData.layers[i].name;
+            const auto it = std::ranges::find(next, map.layers.end(), name, &tmx::Layer::name);
+            if (it == map.layers.end())
+            {
+                TEH_MAP_LOG(WARN, "Render layer {} '{}' has no matching parsed layer, drawing it without offset or parallax",
+                            i, name);
+                continue;
+            }
+            next = it + 1;
+
+            transforms[i] = {it->offsetx, it->offsety, it->parallaxx, it->parallaxy};
+            if (transforms[i] != LayerTransform{})
+            {
+                TEH_MAP_LOG(DEBUG, "Layer '{}': offset {}x{}, parallax {}x{}", it->name,
+                            it->offsetx, it->offsety, it->parallaxx, it->parallaxy);
+            }
+        }
+
         size_t totalTiles = 0;
         size_t animatedTiles = 0;
-        for (const auto& layer : m_RenderData.layers)
+        bool hasBounds = false;
+        float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+        for (size_t layerIndex = 0; layerIndex < m_RenderData.layers.size(); ++layerIndex)
         {
+            const auto& layer = m_RenderData.layers[layerIndex];
+            const auto& transform = transforms[layerIndex];
             totalTiles += layer.tiles.size();
             for (const auto& tile : layer.tiles)
             {
@@ -81,45 +117,175 @@ namespace teh::map
                 {
                     animatedTiles++;
                 }
+
+                // Infinite maps may place chunks at negative coordinates, so measure the real extent.
+                // Parallax depends on the view and is left out.
+                const auto x = static_cast<float>(tile.destX) + transform.offsetX;
+                const auto y = static_cast<float>(tile.destY) + transform.offsetY;
+                if (!hasBounds)
+                {
+                    minX = maxX = x;
+                    minY = maxY = y;
+                    hasBounds = true;
+                }
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x + static_cast<float>(tile.destW));
+                maxY = std::max(maxY, y + static_cast<float>(tile.destH));
             }
             TEH_MAP_LOG(DEBUG, "Layer '{}': {} tiles", layer.name, layer.tiles.size());
         }
         TEH_MAP_LOG(DEBUG, "Total renderable tiles: {} ({} animated)", totalTiles, animatedTiles);
+        m_Bounds = {minX, minY, maxX - minX, maxY - minY};
 
-        // Load all tileset textures
-        TEH_MAP_LOG(INFO, "Loading tileset textures...");
-        m_TilesetTextures.clear();
+        // Group tiles by draw variant once, so the per-frame loop stays branch-free
+        m_MapRenderer.prepare(m_RenderData, transforms);
 
-        for (size_t i = 0; i < m_RenderData.tilesets.size(); ++i)
+        // Object groups don't flow through the render data, ingest them straight from the parsed map
+        TEH_MAP_LOG(INFO, "Loading object groups...");
+        m_Objects.load(map);
+
+        // Decoding is the slow part of texture loading and needs no graphics state
+        TEH_MAP_LOG(INFO, "Decoding tileset images...");
+        if (!m_Backend.decodeTilesets(m_RenderData, m_Images))
         {
-            const auto& tileset = m_RenderData.tilesets[i];
+            return false;
+        }
 
-            TEH_MAP_LOG(DEBUG, "Loading tileset {}: '{}' from {}", i, tileset.name, tileset.imagePath);
+        // Size what finalize() will create, so a budget can be checked before the upload.
+        // Overview chunks are counted with the same bucketing the bake uses.
+        m_PreparedBytes = getRenderDataBytes(m_RenderData) + m_MapRenderer.getMemoryUsage() + m_Objects.getMemoryUsage()
+                        + m_Backend.getTilesetBytes(m_Images);
+        if (m_Backend.getSdlRenderer())
+        {
+            m_PreparedBytes += Overview::estimateTextureBytes(m_RenderData, m_Transforms);
+        }
 
-            SDL_Texture* texture = IMG_LoadTexture(m_Renderer, tileset.imagePath.c_str());
-            if (!texture)
+        m_Prepared = true;
+        return true;
+    }
+
+    bool Map::finalize()
+    {
+        if (!m_Prepared)
+        {
+            return false;
+        }
+
+        if (m_Loaded)
+        {
+            return true;
+        }
+
+        // Upload all tileset textures
+        TEH_MAP_LOG(INFO, "Loading tileset textures ({})...", m_Backend.getName());
+        m_Tilesets = m_Backend.createTilesets(m_RenderData, m_Images);
+        m_Images.clear();
+        if (!m_Tilesets)
+        {
+            return false;
+        }
+
+        // Overview and lighting are SDL_Renderer passes, unavailable on other backends
+        if (m_Backend.getSdlRenderer())
+        {
+            TEH_MAP_LOG(INFO, "Building overview levels...");
+            if (!m_Overview.build(m_RenderData, m_Tilesets->getSdlTextures(), m_Transforms))
             {
-                TEH_RESOURCE_LOG(ERROR, "Failed to load tileset texture: {} | SDL Error: {}", tileset.imagePath, SDL_GetError());
-                return false;
+                TEH_MAP_LOG(WARN, "Overview levels unavailable, zoomed-out rendering falls back to tiles");
             }
 
-            TEH_RESOURCE_LOG(DEBUG, "Texture loaded successfully: {}", tileset.imagePath);
-            m_TilesetTextures.push_back(texture);
+            TEH_MAP_LOG(INFO, "Extracting lights...");
+            if (!m_Lighting.build(m_RenderData, m_Transforms))
+            {
+                TEH_MAP_LOG(WARN, "Lighting resources unavailable, lightmap pass disabled");
+            }
+        }
+        else
+        {
+            TEH_MAP_LOG(INFO, "{} backend: overview levels and lighting disabled", m_Backend.getName());
         }
 
         TEH_MAP_LOG(INFO, "Map loaded successfully!");
         m_Loaded = true;
+        getStats().log();
         return true;
     }
 
-    void Map::render(uint32_t deltaTime)
+    void Map::render(const Camera& camera, uint32_t deltaTime)
     {
         if (!m_Loaded)
         {
             return;
         }
 
-        // Delegate rendering to the Renderer class
-        m_MapRenderer.render(m_RenderData, m_TilesetTextures, deltaTime);
+        m_Backend.bindTilesets(m_Tilesets);
+
+        // Far zoom levels draw the baked overview instead of individual tiles
+        const uint32_t level = m_Overview.selectLevel(camera.zoom);
+        if (level > 0)
+        {
+            m_MapRenderer.update(deltaTime);
+            m_Backend.addDrawCalls(m_Overview.render(level, camera));
+        }
+        else
+        {
+            // Delegate rendering to the Renderer class
+            m_MapRenderer.render(m_RenderData, camera, deltaTime);
+        }
+
+        m_Backend.addDrawCalls(m_Lighting.render(m_RenderData, m_MapRenderer.getAnimationStates(), camera));
+    }
+
+    size_t Map::getMemoryUsage() const
+    {
+        if (m_Loaded)
+        {
+            const MapStats stats = getStats();
+            return stats.getCpuBytes() + stats.getGpuBytes();
+        }
+
+        // Prepared only; the light buffer follows the output size, known on the main thread
+        size_t bytes = m_PreparedBytes;
+        if (m_Prepared && m_Backend.getSdlRenderer())
+        {
+            int width = 0;
+            int height = 0;
+            m_Backend.getOutputSize(width, height);
+            bytes += Lighting::estimateTextureBytes(width, height);
+        }
+        return bytes;
+    }
+
+    MapStats Map::getStats() const
+    {
+        MapStats stats;
+        if (!m_Loaded)
+        {
+            return stats;
+        }
+
+        stats.renderDataBytes = getRenderDataBytes(m_RenderData);
+        stats.rendererBytes = m_MapRenderer.getMemoryUsage();
+        stats.objectBytes = m_Objects.getMemoryUsage();
+        stats.animationStates = m_MapRenderer.getAnimationStates().size();
+
+        m_Tilesets->getStats(stats.tilesets);
+        for (const auto& tileset : stats.tilesets)
+        {
+            stats.tilesetBytes += tileset.getBytes();
+        }
+
+        stats.overviewRegions = m_Overview.getRegionCount();
+        stats.overviewChunks = m_Overview.getChunkCount();
+        for (uint32_t level = 1; level <= m_Overview.getLevelCount(); ++level)
+        {
+            stats.residentChunks.push_back(m_Overview.getResidentChunkCount(level));
+        }
+        stats.overviewBytes = m_Overview.getTextureBytes();
+
+        stats.lightCount = m_Lighting.getLights().size();
+        stats.lightingBytes = m_Lighting.getTextureBytes();
+        return stats;
     }
 }
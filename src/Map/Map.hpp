@@ -6,6 +6,10 @@
 #include <vector>
 #include <tmx/tmx.hpp>
 #include "Renderer.hpp"
+#include "Overview.hpp"
+#include "Lighting.hpp"
+#include "Objects.hpp"
+#include "Telemetry.hpp"
 
 namespace teh::map
 {
@@ -15,27 +19,56 @@ namespace teh::map
     class Map
     {
     public:
-        explicit Map(SDL_Renderer* renderer);
+        explicit Map(TileBackend& backend);
         ~Map();
 
         /**
          * @brief Load a TMX map file
+         *
+         * Same as prepare() followed by finalize().
          * @param filePath Path to the .tmx file
          * @return true if loaded successfully, false otherwise
          */
         bool load(const std::string& filePath);
 
+        /**
+         * @brief CPU half of loading: parse, build render data and decode tileset images
+         *
+         * Touches no graphics state and may run on a loader thread, as long as nothing
+         * else uses this map meanwhile.
+         * @param filePath Path to the .tmx file
+         * @return true if the map is ready for finalize()
+         */
+        bool prepare(const std::string& filePath);
+
+        /**
+         * @brief Graphics half of loading: upload tilesets, bake overview and lighting
+         *
+         * Main thread only. Frees the decoded images.
+         * @return true if the map is ready to render
+         */
+        bool finalize();
+
         /**
          * @brief Render the map with animations
+         *
+         * Switches to the pre-rendered overview levels when the camera is zoomed out,
+         * then applies the lightmap.
+         * @param camera View to render
          * @param deltaTime Time elapsed since last frame in milliseconds
          */
-        void render(uint32_t deltaTime);
+        void render(const Camera& camera, uint32_t deltaTime);
 
         /**
          * @brief Check if a map is currently loaded
          */
         bool isLoaded() const { return m_Loaded; }
 
+        /**
+         * @brief Check if prepare() succeeded
+         */
+        bool isPrepared() const { return m_Prepared; }
+
         /**
          * @brief Get map dimensions in pixels
          */
@@ -48,11 +81,53 @@ namespace teh::map
         uint32_t getWidth() const { return m_RenderData.mapWidth; }
         uint32_t getHeight() const { return m_RenderData.mapHeight; }
 
+        /**
+         * @brief Get the world-space area covered by tiles
+         */
+        const SDL_FRect& getBounds() const { return m_Bounds; }
+
+        /**
+         * @brief Get the pre-rendered overview levels (used by the minimap)
+         */
+        const Overview& getOverview() const { return m_Overview; }
+
+        /**
+         * @brief Get the lightmap pass (ambient and on/off control)
+         */
+        Lighting& getLighting() { return m_Lighting; }
+
+        /**
+         * @brief Get the object groups (triggers, interactables) with their spatial index
+         */
+        const ObjectStore& getObjects() const { return m_Objects; }
+
+        /**
+         * @brief Measure the CPU and GPU memory held by the loaded map
+         */
+        MapStats getStats() const;
+
+        /**
+         * @brief Total CPU and GPU bytes
+         *
+         * Before finalize() this is an estimate of what finalize() will allocate: the
+         * tileset textures as the backend lays them out, the overview chunk levels and
+         * the lighting buffers. Main thread only.
+         */
+        size_t getMemoryUsage() const;
+
     private:
-        SDL_Renderer* m_Renderer;
+        TileBackend& m_Backend;
         Renderer m_MapRenderer;
+        Overview m_Overview;
+        Lighting m_Lighting;
+        ObjectStore m_Objects;
         tmx::render::MapRenderData m_RenderData;
-        std::vector<SDL_Texture*> m_TilesetTextures;
+        std::vector<LayerTransform> m_Transforms;
+        TilesetImages m_Images;
+        TilesetSet* m_Tilesets;
+        size_t m_PreparedBytes{};       // Estimate made by prepare(), lighting aside
+        SDL_FRect m_Bounds{};
+        bool m_Prepared;
         bool m_Loaded;
     };
 }
@@ -0,0 +1,377 @@
+#include "Objects.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace teh::map
+{
+    namespace
+    {
+        /**
+         * @brief Inclusive AABB test, so zero-sized point objects still overlap
+         */
+        bool overlaps(const SDL_FRect& a, const SDL_FRect& b)
+        {
+            return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+        }
+
+        uint8_t classify(const tmx::Object& object)
+        {
+            uint8_t flags = OBJECT_NONE;
+
+            if (object.type == "trigger")
+            {
+                flags |= OBJECT_TRIGGER;
+            }
+            if (object.type == "chest" || object.type == "lever" || object.type == "door" || object.type == "interactable")
+            {
+                flags |= OBJECT_INTERACTABLE;
+            }
+
+            for (const auto& property : object.properties)
+            {
+                if (property.value != "true")
+                    continue;
+
+                if (property.name == "trigger")
+                {
+                    flags |= OBJECT_TRIGGER;
+                }
+                else if (property.name == "interactable")
+                {
+                    flags |= OBJECT_INTERACTABLE;
+                }
+            }
+
+            return flags;
+        }
+    }
+
+    void ObjectStore::clear()
+    {
+        m_Objects.clear();
+        m_Points.clear();
+        m_Properties.clear();
+        m_Strings.clear();
+        m_StringIndex.clear();
+        m_Cells.clear();
+        m_CellObjects.clear();
+        m_LargeObjects.clear();
+    }
+
+    uint32_t ObjectStore::intern(const std::string_view value)
+    {
+        std::string key(value);
+        if (const auto it = m_StringIndex.find(key); it != m_StringIndex.end())
+        {
+            return it->second;
+        }
+
+        const auto index = static_cast<uint32_t>(m_Strings.size());
+        m_Strings.push_back(key);
+        m_StringIndex.emplace(std::move(key), index);
+        return index;
+    }
+
+    void ObjectStore::load(const tmx::Map& map, const float cellSize)
+    {
+        clear();
+        m_CellSize = cellSize;
+
+        // Index 0 is the empty string, shared by every unnamed object
+        intern("");
+
+        std::vector<SDL_FPoint> outline;
+
+        for (const auto& group : map.objectgroups)
+        {
+            const uint32_t groupIndex = intern(group.name);
+
+            for (const auto& object : group.objects)
+            {
+                MapObject entry;
+                entry.id = object.id;
+                entry.nameIndex = intern(object.name);
+                entry.typeIndex = intern(object.type);
+                entry.groupIndex = groupIndex;
+                entry.flags = classify(object);
+
+                // Outline relative to the object origin
+                outline.clear();
+                if (!object.polygon.empty() || !object.polyline.empty())
+                {
+                    entry.shape = object.polygon.empty() ? ObjectShape::Polyline : ObjectShape::Polygon;
+                    for (const auto& point : object.polygon.empty() ? object.polyline : object.polygon)
+                    {
+                        outline.push_back({point.x, point.y});
+                    }
+                }
+                else if (object.point)
+                {
+                    entry.shape = ObjectShape::Point;
+                    outline.push_back({0.0f, 0.0f});
+                }
+                else if (object.gid != 0)
+                {
+                    // Tile objects are anchored at their bottom-left corner
+                    entry.shape = ObjectShape::Tile;
+                    outline = {{0.0f, -object.height}, {object.width, -object.height}, {object.width, 0.0f}, {0.0f, 0.0f}};
+                }
+                else
+                {
+                    entry.shape = object.ellipse ? ObjectShape::Ellipse : ObjectShape::Rectangle;
+                    outline = {{0.0f, 0.0f}, {object.width, 0.0f}, {object.width, object.height}, {0.0f, object.height}};
+                }
+
+                // Tiled rotates clockwise around the object origin
+                const float angle = object.rotation * std::numbers::pi_v<float> / 180.0f;
+                const float cosAngle = std::cos(angle);
+                const float sinAngle = std::sin(angle);
+                const float originX = object.x + group.offsetx;
+                const float originY = object.y + group.offsety;
+
+                float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+                for (size_t i = 0; i < outline.size(); ++i)
+                {
+                    auto& point = outline[i];
+                    point = {
+                        originX + point.x * cosAngle - point.y * sinAngle,
+                        originY + point.x * sinAngle + point.y * cosAngle
+                    };
+
+                    minX = i == 0 ? point.x : std::min(minX, point.x);
+                    minY = i == 0 ? point.y : std::min(minY, point.y);
+                    maxX = i == 0 ? point.x : std::max(maxX, point.x);
+                    maxY = i == 0 ? point.y : std::max(maxY, point.y);
+                }
+                entry.bounds = {minX, minY, maxX - minX, maxY - minY};
+
+                // Rect-like shapes are fully described by their bounds when unrotated
+                if (entry.shape == ObjectShape::Point || entry.shape == ObjectShape::Polygon ||
+                    entry.shape == ObjectShape::Polyline || object.rotation != 0.0f)
+                {
+                    entry.firstPoint = static_cast<uint32_t>(m_Points.size());
+                    entry.pointCount = static_cast<uint32_t>(outline.size());
+                    m_Points.insert(m_Points.end(), outline.begin(), outline.end());
+                }
+
+                entry.firstProperty = static_cast<uint32_t>(m_Properties.size());
+                entry.propertyCount = static_cast<uint32_t>(object.properties.size());
+                for (const auto& property : object.properties)
+                {
+                    m_Properties.push_back({intern(property.name), intern(property.value)});
+                }
+
+                m_Objects.push_back(entry);
+            }
+        }
+
+        buildGrid();
+
+        TEH_MAP_LOG(DEBUG, "Loaded {} objects from {} object groups ({} occupied cells, {} large objects)",
+                    m_Objects.size(), map.objectgroups.size(), m_Cells.size(), m_LargeObjects.size());
+    }
+
+    void ObjectStore::buildGrid()
+    {
+        m_Cells.clear();
+        m_CellObjects.clear();
+        m_LargeObjects.clear();
+
+        const auto isLarge = [](const int32_t x0, const int32_t y0, const int32_t x1, const int32_t y1) {
+            return (static_cast<int64_t>(x1) - x0 + 1) * (static_cast<int64_t>(y1) - y0 + 1) > MAX_OBJECT_CELLS;
+        };
+
+        // Count, prefix-sum, then scatter
+        for (uint32_t index = 0; index < m_Objects.size(); ++index)
+        {
+            int32_t x0, y0, x1, y1;
+            cellRange(m_Objects[index].bounds, x0, y0, x1, y1);
+            if (isLarge(x0, y0, x1, y1))
+            {
+                m_LargeObjects.push_back(index);
+                continue;
+            }
+
+            if (m_Cells.empty())
+            {
+                m_MinCellX = x0;
+                m_MinCellY = y0;
+                m_MaxCellX = x1;
+                m_MaxCellY = y1;
+            }
+            m_MinCellX = std::min(m_MinCellX, x0);
+            m_MinCellY = std::min(m_MinCellY, y0);
+            m_MaxCellX = std::max(m_MaxCellX, x1);
+            m_MaxCellY = std::max(m_MaxCellY, y1);
+
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                for (int32_t x = x0; x <= x1; ++x)
+                {
+                    m_Cells[cellKey(x, y)].count++;
+                }
+            }
+        }
+
+        uint32_t first = 0;
+        for (auto& [key, range] : m_Cells)
+        {
+            range.first = first;
+            first += range.count;
+            range.count = 0;
+        }
+
+        m_CellObjects.resize(first);
+        for (uint32_t index = 0; index < m_Objects.size(); ++index)
+        {
+            int32_t x0, y0, x1, y1;
+            cellRange(m_Objects[index].bounds, x0, y0, x1, y1);
+            if (isLarge(x0, y0, x1, y1))
+            {
+                continue;
+            }
+
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                for (int32_t x = x0; x <= x1; ++x)
+                {
+                    auto& range = m_Cells[cellKey(x, y)];
+                    m_CellObjects[range.first + range.count++] = index;
+                }
+            }
+        }
+    }
+
+    int32_t ObjectStore::toCell(const float coordinate) const
+    {
+        // Far beyond any real map, but keeps span arithmetic and key packing safe
+        constexpr float CELL_LIMIT = 1 << 30;
+        return static_cast<int32_t>(std::clamp(std::floor(coordinate / m_CellSize), -CELL_LIMIT, CELL_LIMIT));
+    }
+
+    void ObjectStore::cellRange(const SDL_FRect& rect, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1) const
+    {
+        x0 = toCell(rect.x);
+        y0 = toCell(rect.y);
+        x1 = toCell(rect.x + rect.w);
+        y1 = toCell(rect.y + rect.h);
+    }
+
+    void ObjectStore::reportFromCell(const uint32_t index, const SDL_FRect& area, const int32_t x0, const int32_t y0,
+                                     const int32_t x, const int32_t y,
+                                     std::vector<uint32_t>& results, const uint8_t flagMask) const
+    {
+        const auto& object = m_Objects[index];
+
+        if (flagMask != OBJECT_NONE && (object.flags & flagMask) == 0)
+            return;
+
+        if (!overlaps(object.bounds, area))
+            return;
+
+        // An object spanning several cells is reported only from the first cell it shares with the query
+        int32_t ox0, oy0, ox1, oy1;
+        cellRange(object.bounds, ox0, oy0, ox1, oy1);
+        if (x != std::max(x0, ox0) || y != std::max(y0, oy0))
+            return;
+
+        results.push_back(index);
+    }
+
+    void ObjectStore::query(const SDL_FRect& area, std::vector<uint32_t>& results, const uint8_t flagMask) const
+    {
+        for (const uint32_t index : m_LargeObjects)
+        {
+            const auto& object = m_Objects[index];
+            if ((flagMask == OBJECT_NONE || (object.flags & flagMask) != 0) && overlaps(object.bounds, area))
+            {
+                results.push_back(index);
+            }
+        }
+
+        if (m_Cells.empty())
+        {
+            return;
+        }
+
+        int32_t x0, y0, x1, y1;
+        cellRange(area, x0, y0, x1, y1);
+        x0 = std::max(x0, m_MinCellX);
+        y0 = std::max(y0, m_MinCellY);
+        x1 = std::min(x1, m_MaxCellX);
+        y1 = std::min(y1, m_MaxCellY);
+        if (x0 > x1 || y0 > y1)
+        {
+            return;
+        }
+
+        // A query wider than the occupied set walks the cells that exist instead of every cell it covers
+        const int64_t span = (static_cast<int64_t>(x1) - x0 + 1) * (static_cast<int64_t>(y1) - y0 + 1);
+        if (span > static_cast<int64_t>(m_Cells.size()))
+        {
+            for (const auto& [key, range] : m_Cells)
+            {
+                const auto x = static_cast<int32_t>(key >> 32);
+                const auto y = static_cast<int32_t>(static_cast<uint32_t>(key));
+                if (x < x0 || x > x1 || y < y0 || y > y1)
+                    continue;
+
+                for (uint32_t i = range.first; i < range.first + range.count; ++i)
+                {
+                    reportFromCell(m_CellObjects[i], area, x0, y0, x, y, results, flagMask);
+                }
+            }
+            return;
+        }
+
+        for (int32_t y = y0; y <= y1; ++y)
+        {
+            for (int32_t x = x0; x <= x1; ++x)
+            {
+                const auto it = m_Cells.find(cellKey(x, y));
+                if (it == m_Cells.end())
+                    continue;
+
+                const auto& range = it->second;
+                for (uint32_t i = range.first; i < range.first + range.count; ++i)
+                {
+                    reportFromCell(m_CellObjects[i], area, x0, y0, x, y, results, flagMask);
+                }
+            }
+        }
+    }
+
+    std::string_view ObjectStore::getProperty(const MapObject& object, const std::string_view name) const
+    {
+        for (uint32_t i = 0; i < object.propertyCount; ++i)
+        {
+            const auto& property = m_Properties[object.firstProperty + i];
+            if (m_Strings[property.nameIndex] == name)
+            {
+                return m_Strings[property.valueIndex];
+            }
+        }
+        return {};
+    }
+
+    size_t ObjectStore::getMemoryUsage() const
+    {
+        size_t bytes = m_Objects.capacity() * sizeof(MapObject)
+                     + m_Points.capacity() * sizeof(SDL_FPoint)
+                     + m_Properties.capacity() * sizeof(ObjectProperty)
+                     + m_Strings.capacity() * sizeof(std::string)
+                     + m_StringIndex.size() * (sizeof(std::string) + sizeof(uint32_t))
+                     + m_Cells.size() * (sizeof(uint64_t) + sizeof(CellRange))
+                     + m_CellObjects.capacity() * sizeof(uint32_t)
+                     + m_LargeObjects.capacity() * sizeof(uint32_t);
+
+        // Strings are stored twice: in the table and as index keys
+        for (const auto& string : m_Strings)
+        {
+            bytes += string.capacity() * 2;
+        }
+        return bytes;
+    }
+}
@@ -0,0 +1,177 @@
+#ifndef THEELDERWOODHILL_OBJECTS_HPP
+#define THEELDERWOODHILL_OBJECTS_HPP
+
+#include <SDL3/SDL.h>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ankerl/unordered_dense.h>
+#include <tmx/tmx.hpp>
+
+namespace teh::map
+{
+    enum class ObjectShape : uint8_t
+    {
+        Rectangle,
+        Ellipse,
+        Point,
+        Polygon,
+        Polyline,
+        Tile
+    };
+
+    /**
+     * @brief Gameplay role of an object, derived from its type or custom properties
+     */
+    enum ObjectFlags : uint8_t
+    {
+        OBJECT_NONE = 0,
+        OBJECT_TRIGGER = 1 << 0,
+        OBJECT_INTERACTABLE = 1 << 1
+    };
+
+    /**
+     * @brief Compact engine-side copy of a Tiled object
+     *
+     * Strings, points and properties live in shared pools owned by ObjectStore.
+     */
+    struct MapObject
+    {
+        SDL_FRect bounds{};          // World-space AABB
+        uint32_t id{};
+        uint32_t nameIndex{};
+        uint32_t typeIndex{};
+        uint32_t groupIndex{};       // Name of the owning object group
+        uint32_t firstPoint{};
+        uint32_t pointCount{};
+        uint32_t firstProperty{};
+        uint32_t propertyCount{};
+        ObjectShape shape{};
+        uint8_t flags{};
+    };
+
+    struct ObjectProperty
+    {
+        uint32_t nameIndex{};
+        uint32_t valueIndex{};
+    };
+
+    /**
+     * @brief Object groups of a map, indexed by a uniform-grid spatial hash
+     *
+     * Only occupied cells are stored, keyed by their packed coordinates, so objects
+     * far apart on infinite maps cost nothing in between. Objects are static once
+     * loaded, so each cell holds a flat range of object indices and queries allocate
+     * nothing beyond the caller's result vector.
+     */
+    class ObjectStore
+    {
+    public:
+        static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+
+        // Objects covering more cells than this are tested on every query instead
+        static constexpr int64_t MAX_OBJECT_CELLS = 1024;
+
+        /**
+         * @brief Ingest every object group of a parsed map
+         * @param map Parsed TMX map
+         * @param cellSize Spatial hash cell size in pixels
+         */
+        void load(const tmx::Map& map, float cellSize = DEFAULT_CELL_SIZE);
+
+        void clear();
+
+        /**
+         * @brief Append the indices of objects whose bounds overlap an area
+         * @param area World-space AABB
+         * @param results Receives object indices, each at most once
+         * @param flagMask If non-zero, only objects having any of these flags are reported
+         */
+        void query(const SDL_FRect& area, std::vector<uint32_t>& results, uint8_t flagMask = OBJECT_NONE) const;
+
+        /**
+         * @brief Append the indices of triggers overlapping an area
+         */
+        void queryTriggers(const SDL_FRect& area, std::vector<uint32_t>& results) const
+        {
+            query(area, results, OBJECT_TRIGGER);
+        }
+
+        const MapObject& get(uint32_t index) const { return m_Objects[index]; }
+        size_t size() const { return m_Objects.size(); }
+
+        /**
+         * @brief Heap bytes held by objects, strings and the grid
+         */
+        size_t getMemoryUsage() const;
+
+        /**
+         * @brief World-space vertices of a polygon, polyline or point object
+         */
+        std::span<const SDL_FPoint> getPoints(const MapObject& object) const
+        {
+            return {m_Points.data() + object.firstPoint, object.pointCount};
+        }
+
+        std::string_view getString(uint32_t index) const { return m_Strings[index]; }
+        std::string_view getName(const MapObject& object) const { return m_Strings[object.nameIndex]; }
+        std::string_view getType(const MapObject& object) const { return m_Strings[object.typeIndex]; }
+
+        /**
+         * @brief Look up a custom property, empty if absent
+         */
+        std::string_view getProperty(const MapObject& object, std::string_view name) const;
+
+    private:
+        // Objects of a cell are m_CellObjects[first .. first + count)
+        struct CellRange
+        {
+            uint32_t first{};
+            uint32_t count{};
+        };
+
+        static uint64_t cellKey(const int32_t x, const int32_t y)
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+        }
+
+        uint32_t intern(std::string_view value);
+        void buildGrid();
+
+        /**
+         * @brief Cell coordinate of a world coordinate, kept well inside int32
+         */
+        int32_t toCell(float coordinate) const;
+
+        /**
+         * @brief Inclusive cell range covered by a rect
+         */
+        void cellRange(const SDL_FRect& rect, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1) const;
+
+        /**
+         * @brief Append an object found in cell x, y unless filtered out or reported from another cell
+         */
+        void reportFromCell(uint32_t index, const SDL_FRect& area, int32_t x0, int32_t y0, int32_t x, int32_t y,
+                            std::vector<uint32_t>& results, uint8_t flagMask) const;
+
+        std::vector<MapObject> m_Objects;
+        std::vector<SDL_FPoint> m_Points;
+        std::vector<ObjectProperty> m_Properties;
+        std::vector<std::string> m_Strings;
+        ankerl::unordered_dense::map<std::string, uint32_t> m_StringIndex;
+
+        float m_CellSize{DEFAULT_CELL_SIZE};
+        ankerl::unordered_dense::map<uint64_t, CellRange> m_Cells;
+        std::vector<uint32_t> m_CellObjects;
+        std::vector<uint32_t> m_LargeObjects;
+
+        // Bounds of the occupied cells, queries are clamped to them
+        int32_t m_MinCellX{};
+        int32_t m_MinCellY{};
+        int32_t m_MaxCellX{};
+        int32_t m_MaxCellY{};
+    };
+}
+
+#endif //THEELDERWOODHILL_OBJECTS_HPP
@@ -0,0 +1,409 @@
+#include "Overview.hpp"
+#include "SdlTileBackend.hpp"
+#include "Telemetry.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace teh::map
+{
+    Overview::Overview(SDL_Renderer* sdlRenderer)
+        : m_SdlRenderer(sdlRenderer)
+    {
+    }
+
+    Overview::~Overview()
+    {
+        clear();
+    }
+
+    void Overview::clear()
+    {
+        for (auto& region : m_Regions)
+        {
+            for (auto& chunk : region.chunks)
+            {
+                for (auto* texture : chunk.levels)
+                {
+                    if (texture)
+                    {
+                        SDL_DestroyTexture(texture);
+                    }
+                }
+            }
+        }
+        m_Regions.clear();
+        m_LevelCount = 0;
+    }
+
+    bool Overview::build(const tmx::render::MapRenderData& renderData,
+                         const std::vector<SDL_Texture*>& tilesetTextures,
+                         const std::vector<LayerTransform>& transforms)
+    {
+        clear();
+
+        if (renderData.mapWidth == 0 || renderData.mapHeight == 0 || transforms.size() != renderData.layers.size())
+        {
+            return true;
+        }
+
+        getLayout(renderData, m_ChunkPixelWidth, m_ChunkPixelHeight, m_LevelCount);
+
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(m_SdlRenderer);
+        SDL_Texture* scratch = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                                 m_ChunkPixelWidth, m_ChunkPixelHeight);
+        if (!scratch)
+        {
+            TEH_GRAPHICS_LOG(ERROR, "Failed to create overview scratch target: {}", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureScaleMode(scratch, SDL_SCALEMODE_LINEAR);
+
+        // Consecutive layers that move together share one region
+        bool success = true;
+        for (size_t first = 0; first < renderData.layers.size() && success;)
+        {
+            const size_t last = getRegionEnd(transforms, first);
+
+            Region region;
+            region.transform = transforms[first];
+            success = bakeRegion(region, renderData, tilesetTextures, first, last, scratch);
+            if (!region.chunks.empty())
+            {
+                m_Regions.push_back(std::move(region));
+            }
+
+            first = last;
+        }
+
+        SDL_SetRenderTarget(m_SdlRenderer, previousTarget);
+        SDL_DestroyTexture(scratch);
+
+        TEH_MAP_LOG(DEBUG, "Overview built - {} levels, {} regions, {} chunks", m_LevelCount, m_Regions.size(), getChunkCount());
+
+        if (!success)
+        {
+            clear();
+        }
+        return success;
+    }
+
+    void Overview::getLayout(const tmx::render::MapRenderData& renderData, int& chunkWidth, int& chunkHeight, uint32_t& levels)
+    {
+        chunkWidth = static_cast<int>(renderData.pixelWidth / renderData.mapWidth * CHUNK_TILES);
+        chunkHeight = static_cast<int>(renderData.pixelHeight / renderData.mapHeight * CHUNK_TILES);
+
+        levels = 0;
+        while (levels < MAX_LEVELS && (std::min(chunkWidth, chunkHeight) >> (levels + 1)) > 0)
+        {
+            levels++;
+        }
+    }
+
+    size_t Overview::getRegionEnd(const std::vector<LayerTransform>& transforms, const size_t first)
+    {
+        size_t last = first + 1;
+        while (last < transforms.size() && transforms[last] == transforms[first])
+        {
+            last++;
+        }
+        return last;
+    }
+
+    Overview::ChunkGrid Overview::bucketRegion(const tmx::render::MapRenderData& renderData,
+                                               const size_t firstLayer, const size_t lastLayer,
+                                               const int chunkWidth, const int chunkHeight)
+    {
+        ChunkGrid grid;
+
+        // Region extent in layer space
+        bool hasBounds = false;
+        float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+        for (size_t i = firstLayer; i < lastLayer; ++i)
+        {
+            const auto& layer = renderData.layers[i];
+            if (!layer.visible)
+                continue;
+
+            for (const auto& tile : layer.tiles)
+            {
+                const auto x = static_cast<float>(tile.destX);
+                const auto y = static_cast<float>(tile.destY);
+                if (!hasBounds)
+                {
+                    minX = maxX = x;
+                    minY = maxY = y;
+                    hasBounds = true;
+                }
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x + static_cast<float>(tile.destW));
+                maxY = std::max(maxY, y + static_cast<float>(tile.destH));
+            }
+        }
+
+        if (!hasBounds)
+        {
+            return grid;
+        }
+
+        const auto chunkW = static_cast<float>(chunkWidth);
+        const auto chunkH = static_cast<float>(chunkHeight);
+        const auto chunksX = static_cast<uint32_t>(std::ceil((maxX - minX) / chunkW));
+        const auto chunksY = static_cast<uint32_t>(std::ceil((maxY - minY) / chunkH));
+        grid.minX = minX;
+        grid.minY = minY;
+        grid.chunksX = chunksX;
+        grid.chunksY = chunksY;
+
+        // Bucket tiles into every chunk they touch, preserving layer order
+        auto& buckets = grid.buckets;
+        buckets.resize(static_cast<size_t>(chunksX) * chunksY);
+        for (size_t i = firstLayer; i < lastLayer; ++i)
+        {
+            const auto& layer = renderData.layers[i];
+            if (!layer.visible)
+                continue;
+
+            for (const auto& tile : layer.tiles)
+            {
+                // Convert before adding: a negative destX plus an unsigned destW would wrap around
+                const auto tileX = static_cast<float>(tile.destX);
+                const auto tileY = static_cast<float>(tile.destY);
+                const auto x0 = static_cast<int64_t>(std::floor((tileX - minX) / chunkW));
+                const auto y0 = static_cast<int64_t>(std::floor((tileY - minY) / chunkH));
+                const auto x1 = static_cast<int64_t>(std::floor((tileX + static_cast<float>(tile.destW) - 1.0f - minX) / chunkW));
+                const auto y1 = static_cast<int64_t>(std::floor((tileY + static_cast<float>(tile.destH) - 1.0f - minY) / chunkH));
+
+                for (int64_t cy = std::max<int64_t>(y0, 0); cy <= std::min<int64_t>(y1, chunksY - 1); ++cy)
+                {
+                    for (int64_t cx = std::max<int64_t>(x0, 0); cx <= std::min<int64_t>(x1, chunksX - 1); ++cx)
+                    {
+                        buckets[static_cast<size_t>(cy) * chunksX + cx].push_back(&tile);
+                    }
+                }
+            }
+        }
+
+        return grid;
+    }
+
+    bool Overview::bakeRegion(Region& region,
+                              const tmx::render::MapRenderData& renderData,
+                              const std::vector<SDL_Texture*>& tilesetTextures,
+                              const size_t firstLayer, const size_t lastLayer,
+                              SDL_Texture* scratch)
+    {
+        const ChunkGrid grid = bucketRegion(renderData, firstLayer, lastLayer, m_ChunkPixelWidth, m_ChunkPixelHeight);
+        const auto chunkW = static_cast<float>(m_ChunkPixelWidth);
+        const auto chunkH = static_cast<float>(m_ChunkPixelHeight);
+
+        // Only chunks with tiles are kept: sparse parallax layers stay cheap
+        for (uint32_t cy = 0; cy < grid.chunksY; ++cy)
+        {
+            for (uint32_t cx = 0; cx < grid.chunksX; ++cx)
+            {
+                const auto& tiles = grid.buckets[static_cast<size_t>(cy) * grid.chunksX + cx];
+                if (tiles.empty())
+                {
+                    continue;
+                }
+
+                Chunk chunk;
+                chunk.worldRect = {grid.minX + cx * chunkW, grid.minY + cy * chunkH, chunkW, chunkH};
+
+                SDL_SetRenderTarget(m_SdlRenderer, scratch);
+                SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 0);
+                SDL_RenderClear(m_SdlRenderer);
+                bakeChunk(tilesetTextures, tiles, chunk.worldRect);
+
+                // Each level is a linear downsample of the previous one. Targets hold
+                // premultiplied colour, so copies must not blend again.
+                SDL_Texture* source = scratch;
+                for (uint32_t level = 1; level <= m_LevelCount; ++level)
+                {
+                    SDL_Texture* texture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA32,
+                                                             SDL_TEXTUREACCESS_TARGET,
+                                                             m_ChunkPixelWidth >> level, m_ChunkPixelHeight >> level);
+                    if (!texture)
+                    {
+                        TEH_GRAPHICS_LOG(ERROR, "Failed to create overview level {} texture: {}", level, SDL_GetError());
+                        region.chunks.push_back(chunk);
+                        return false;
+                    }
+                    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_LINEAR);
+                    SDL_SetTextureBlendMode(source, SDL_BLENDMODE_NONE);
+                    SDL_SetRenderTarget(m_SdlRenderer, texture);
+                    SDL_RenderTexture(m_SdlRenderer, source, nullptr, nullptr);
+                    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+                    chunk.levels[level - 1] = texture;
+                    source = texture;
+                }
+
+                region.chunks.push_back(chunk);
+            }
+        }
+
+        return true;
+    }
+
+    void Overview::bakeChunk(const std::vector<SDL_Texture*>& tilesetTextures,
+                             const std::vector<const tmx::render::TileRenderData*>& tiles,
+                             const SDL_FRect& worldRect) const
+    {
+        for (const auto* tile : tiles)
+        {
+            if (tile->tilesetIndex >= tilesetTextures.size() || !tilesetTextures[tile->tilesetIndex])
+            {
+                continue;
+            }
+
+            SDL_Texture* texture = tilesetTextures[tile->tilesetIndex];
+
+            // Animated tiles are baked with their base frame
+            const SDL_FRect srcRect = {
+                static_cast<float>(tile->srcX),
+                static_cast<float>(tile->srcY),
+                static_cast<float>(tile->srcW),
+                static_cast<float>(tile->srcH)
+            };
+            const SDL_FRect destRect = {
+                static_cast<float>(tile->destX) - worldRect.x,
+                static_cast<float>(tile->destY) - worldRect.y,
+                static_cast<float>(tile->destW),
+                static_cast<float>(tile->destH)
+            };
+
+            if (tile->opacity < 1.0f)
+            {
+                SdlTileBackend::setOpacity(texture, tile->opacity);
+            }
+
+            SdlTileBackend::renderTile(m_SdlRenderer, texture, srcRect, destRect, getTileFlips(*tile));
+
+            if (tile->opacity < 1.0f)
+            {
+                SdlTileBackend::setOpacity(texture, 1.0f);
+            }
+        }
+    }
+
+    uint32_t Overview::render(const uint32_t level, const Camera& camera, const bool parallax) const
+    {
+        if (level == 0 || level > m_LevelCount)
+        {
+            return 0;
+        }
+
+        uint32_t drawn = 0;
+        for (const auto& region : m_Regions)
+        {
+            const Camera regionCamera = parallax ? region.transform.apply(camera) : region.transform.applyOffset(camera);
+            const SDL_FRect view = regionCamera.getWorldRect();
+
+            for (const auto& chunk : region.chunks)
+            {
+                SDL_Texture* texture = chunk.levels[level - 1];
+                if (!texture || !intersects(chunk.worldRect, view))
+                {
+                    continue;
+                }
+
+                const SDL_FRect destRect = regionCamera.toScreen(chunk.worldRect);
+                SDL_RenderTexture(m_SdlRenderer, texture, nullptr, &destRect);
+                drawn++;
+            }
+        }
+        return drawn;
+    }
+
+    uint32_t Overview::getChunkCount() const
+    {
+        uint32_t count = 0;
+        for (const auto& region : m_Regions)
+        {
+            count += static_cast<uint32_t>(region.chunks.size());
+        }
+        return count;
+    }
+
+    uint32_t Overview::getResidentChunkCount(const uint32_t level) const
+    {
+        if (level == 0 || level > m_LevelCount)
+        {
+            return 0;
+        }
+
+        uint32_t count = 0;
+        for (const auto& region : m_Regions)
+        {
+            for (const auto& chunk : region.chunks)
+            {
+                if (chunk.levels[level - 1])
+                {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    size_t Overview::getTextureBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& region : m_Regions)
+        {
+            for (const auto& chunk : region.chunks)
+            {
+                for (const auto* texture : chunk.levels)
+                {
+                    bytes += TextureStats::fromTexture({}, texture).getBytes();
+                }
+            }
+        }
+        return bytes;
+    }
+
+    size_t Overview::estimateTextureBytes(const tmx::render::MapRenderData& renderData,
+                                          const std::vector<LayerTransform>& transforms)
+    {
+        if (renderData.mapWidth == 0 || renderData.mapHeight == 0 || transforms.size() != renderData.layers.size())
+        {
+            return 0;
+        }
+
+        int chunkWidth = 0;
+        int chunkHeight = 0;
+        uint32_t levels = 0;
+        getLayout(renderData, chunkWidth, chunkHeight, levels);
+
+        size_t chunkBytes = 0;
+        for (uint32_t level = 1; level <= levels; ++level)
+        {
+            chunkBytes += static_cast<size_t>(chunkWidth >> level) * (chunkHeight >> level) * 4;
+        }
+
+        // Same regions and chunk grids as build(), so the count matches what gets baked
+        size_t chunks = 0;
+        for (size_t first = 0; first < renderData.layers.size();)
+        {
+            const size_t last = getRegionEnd(transforms, first);
+            const ChunkGrid grid = bucketRegion(renderData, first, last, chunkWidth, chunkHeight);
+            chunks += std::ranges::count_if(grid.buckets, [](const auto& bucket) { return !bucket.empty(); });
+            first = last;
+        }
+        return chunks * chunkBytes;
+    }
+
+    uint32_t Overview::selectLevel(const float zoom) const
+    {
+        if (zoom > 0.5f || m_LevelCount == 0)
+        {
+            return 0;
+        }
+
+        const auto level = static_cast<uint32_t>(std::floor(std::log2(1.0f / zoom)));
+        return std::min(level, m_LevelCount);
+    }
+}
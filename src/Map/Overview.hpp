@@ -0,0 +1,156 @@
+#ifndef THEELDERWOODHILL_OVERVIEW_HPP
+#define THEELDERWOODHILL_OVERVIEW_HPP
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <vector>
+#include <tmx/tmx.hpp>
+#include "Camera.hpp"
+
+namespace teh::map
+{
+    /**
+     * @brief Pre-rendered, per-chunk mip-chain of the map for zoomed-out and minimap rendering
+     *
+     * Level N holds the map at 1/2^N scale. Level 0 is never stored: full detail
+     * is always drawn tile by tile by the Renderer.
+     *
+     * Consecutive layers sharing a LayerTransform form one cache region with its own
+     * chunk grid in layer space. Regions are drawn in layer order, each through its
+     * layer camera, so parallax layers scroll without rebaking the others.
+     */
+    class Overview
+    {
+    public:
+        static constexpr uint32_t CHUNK_TILES = 16;
+        static constexpr uint32_t MAX_LEVELS = 4;
+
+        explicit Overview(SDL_Renderer* sdlRenderer);
+        ~Overview();
+
+        Overview(const Overview&) = delete;
+        Overview& operator=(const Overview&) = delete;
+
+        /**
+         * @brief Bake all levels from the loaded render data
+         * @param renderData Pre-calculated render data from tmxparser
+         * @param tilesetTextures Vector of loaded tileset textures
+         * @param transforms Offset and parallax of each layer
+         * @return true if every chunk texture was created
+         */
+        bool build(const tmx::render::MapRenderData& renderData,
+                   const std::vector<SDL_Texture*>& tilesetTextures,
+                   const std::vector<LayerTransform>& transforms);
+
+        /**
+         * @brief Destroy all chunk textures
+         */
+        void clear();
+
+        /**
+         * @brief Draw the chunks of one level visible through the camera
+         * @param level Level to draw, 1..getLevelCount()
+         * @param camera Map view
+         * @param parallax Apply layer parallax; off for whole-map views
+         * @return Number of chunk textures drawn
+         */
+        uint32_t render(uint32_t level, const Camera& camera, bool parallax = true) const;
+
+        /**
+         * @brief Pick the level matching a zoom factor, 0 meaning full detail
+         */
+        uint32_t selectLevel(float zoom) const;
+
+        /**
+         * @brief Number of stored levels (the coarsest level has this index)
+         */
+        uint32_t getLevelCount() const { return m_LevelCount; }
+
+        uint32_t getRegionCount() const { return static_cast<uint32_t>(m_Regions.size()); }
+        uint32_t getChunkCount() const;
+
+        /**
+         * @brief Number of chunks with a baked texture at a level (1..getLevelCount())
+         */
+        uint32_t getResidentChunkCount(uint32_t level) const;
+
+        /**
+         * @brief Total size of all baked chunk textures
+         */
+        size_t getTextureBytes() const;
+
+        /**
+         * @brief Size the chunk textures of build() will take, without baking
+         *
+         * Touches no graphics state, so it may run on a loader thread.
+         */
+        static size_t estimateTextureBytes(const tmx::render::MapRenderData& renderData,
+                                           const std::vector<LayerTransform>& transforms);
+
+    private:
+        struct Chunk
+        {
+            SDL_FRect worldRect{};      // In layer space
+            std::array<SDL_Texture*, MAX_LEVELS> levels{};
+        };
+
+        struct Region
+        {
+            LayerTransform transform;
+            std::vector<Chunk> chunks;
+        };
+
+        // Tiles of a region bucketed per chunk, row-major, starting at minX, minY in layer space
+        struct ChunkGrid
+        {
+            float minX{};
+            float minY{};
+            uint32_t chunksX{};
+            uint32_t chunksY{};
+            std::vector<std::vector<const tmx::render::TileRenderData*>> buckets;
+        };
+
+        /**
+         * @brief Chunk size in pixels and number of levels for a map
+         */
+        static void getLayout(const tmx::render::MapRenderData& renderData,
+                              int& chunkWidth, int& chunkHeight, uint32_t& levels);
+
+        /**
+         * @brief End of the run of layers starting at first that share its transform
+         */
+        static size_t getRegionEnd(const std::vector<LayerTransform>& transforms, size_t first);
+
+        /**
+         * @brief Bucket the visible tiles of layers [firstLayer, lastLayer) into every chunk they touch
+         */
+        static ChunkGrid bucketRegion(const tmx::render::MapRenderData& renderData,
+                                      size_t firstLayer, size_t lastLayer,
+                                      int chunkWidth, int chunkHeight);
+
+        /**
+         * @brief Bake layers [firstLayer, lastLayer) into a region's chunks
+         * @return false if a chunk texture could not be created
+         */
+        bool bakeRegion(Region& region,
+                        const tmx::render::MapRenderData& renderData,
+                        const std::vector<SDL_Texture*>& tilesetTextures,
+                        size_t firstLayer, size_t lastLayer,
+                        SDL_Texture* scratch);
+
+        /**
+         * @brief Draw tiles into a chunk's full-resolution scratch target
+         */
+        void bakeChunk(const std::vector<SDL_Texture*>& tilesetTextures,
+                       const std::vector<const tmx::render::TileRenderData*>& tiles,
+                       const SDL_FRect& worldRect) const;
+
+        SDL_Renderer* m_SdlRenderer;
+        std::vector<Region> m_Regions;
+        int m_ChunkPixelWidth{};
+        int m_ChunkPixelHeight{};
+        uint32_t m_LevelCount{};
+    };
+}
+
+#endif //THEELDERWOODHILL_OVERVIEW_HPP
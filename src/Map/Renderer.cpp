@@ -1,116 +1,219 @@
 #include "Renderer.hpp"
+#include "../Utils/Logger.hpp"
 #include <iostream>
 
 namespace teh::map
 {
-    Renderer::Renderer(SDL_Renderer* sdlRenderer)
-        : m_SdlRenderer(sdlRenderer)
+    const std::array<Renderer::BucketKernel, TILE_VARIANT_COUNT> Renderer::s_Kernels = {
+        &Renderer::renderBucket<0>,
+        &Renderer::renderBucket<1>,
+        &Renderer::renderBucket<2>,
+        &Renderer::renderBucket<3>,
+        &Renderer::renderBucket<4>,
+        &Renderer::renderBucket<5>,
+        &Renderer::renderBucket<6>,
+        &Renderer::renderBucket<7>
+    };
+
+    Renderer::Renderer(TileBackend& backend)
+        : m_Backend(backend)
     {
     }
 
     Renderer::~Renderer() = default;
 
+    void Renderer::prepare(const tmx::render::MapRenderData& renderData,
+                           const std::vector<LayerTransform>& transforms)
+    {
+        m_Layers.assign(renderData.layers.size(), {});
+
+        size_t dropped = 0;
+        std::array<size_t, TILE_VARIANT_COUNT> counts{};
+
+        for (size_t layerIndex = 0; layerIndex < renderData.layers.size(); ++layerIndex)
+        {
+            const auto& layer = renderData.layers[layerIndex];
+            auto& buckets = m_Layers[layerIndex].buckets;
+            if (layerIndex < transforms.size())
+            {
+                m_Layers[layerIndex].transform = transforms[layerIndex];
+            }
+
+            for (uint32_t i = 0; i < layer.tiles.size(); ++i)
+            {
+                const auto& tile = layer.tiles[i];
+
+                // Validate the tileset
+                if (tile.tilesetIndex >= renderData.tilesets.size())
+                {
+                    dropped++;
+                    continue;
+                }
+
+                uint32_t variant = 0;
+
+                if (tile.isAnimated && tile.animationIndex != static_cast<uint32_t>(-1))
+                {
+                    const auto& animations = renderData.tilesets[tile.tilesetIndex].animations;
+                    if (tile.animationIndex >= animations.size())
+                    {
+                        dropped++;
+                        continue;
+                    }
+
+                    // An animation without duration never advances, draw its base frame
+                    if (animations[tile.animationIndex].totalDuration > 0)
+                    {
+                        variant |= TILE_ANIMATED;
+                    }
+                }
+
+                if (tile.opacity < 1.0f)
+                {
+                    variant |= TILE_TRANSLUCENT;
+                }
+
+                if (getTileFlips(tile) != 0)
+                {
+                    variant |= TILE_FLIPPED;
+                }
+
+                buckets[variant].push_back(i);
+                counts[variant]++;
+            }
+        }
+
+        TEH_MAP_LOG(DEBUG, "Tile buckets: {} plain, {} flipped, {} translucent, {} animated, {} mixed, {} dropped",
+                    counts[0], counts[TILE_FLIPPED], counts[TILE_TRANSLUCENT], counts[TILE_ANIMATED],
+                    counts[3] + counts[5] + counts[6] + counts[7], dropped);
+    }
+
     void Renderer::render(const tmx::render::MapRenderData& renderData,
-                         const std::vector<SDL_Texture*>& tilesetTextures,
+                         const Camera& camera,
                          uint32_t deltaTime)
     {
-        // Render all layers
-        for (const auto& layer : renderData.layers)
+        update(deltaTime);
+
+        if (m_Layers.size() != renderData.layers.size())
+        {
+            TEH_MAP_LOG(WARN, "Render data changed without Renderer::prepare, skipping frame");
+            return;
+        }
+
+        for (size_t i = 0; i < renderData.layers.size(); ++i)
         {
-            renderLayer(layer, renderData, tilesetTextures, deltaTime);
+            renderLayer(renderData.layers[i], m_Layers[i], renderData, camera);
         }
     }
 
     void Renderer::renderLayer(const tmx::render::LayerRenderData& layer,
+                               const PreparedLayer& prepared,
                                const tmx::render::MapRenderData& renderData,
-                               const std::vector<SDL_Texture*>& tilesetTextures,
-                               uint32_t deltaTime)
+                               const Camera& camera)
     {
         // Skip invisible layers
         if (!layer.visible)
             return;
 
-        // Render all tiles in the layer
-        for (const auto& tile : layer.tiles)
+        // Culling happens in layer space, so offset and parallax cost nothing per tile
+        const Camera layerCamera = prepared.transform.apply(camera);
+        const SDL_FRect view = layerCamera.getWorldRect();
+        const auto& buckets = prepared.buckets;
+
+        // Layer order is kept; within a layer tiles are grouped by variant and each
+        // bucket goes out as one batch, so the backend picks its draw loop once
+        for (uint32_t variant = 0; variant < TILE_VARIANT_COUNT; ++variant)
         {
-            // Get the tileset texture
-            if (tile.tilesetIndex >= tilesetTextures.size())
+            if (buckets[variant].empty())
             {
                 continue;
             }
 
-            SDL_Texture* texture = tilesetTextures[tile.tilesetIndex];
-            if (!texture)
+            m_Instances.clear();
+            (this->*s_Kernels[variant])(buckets[variant], layer, renderData, layerCamera, view);
+            if (!m_Instances.empty())
             {
-                continue;
+                m_Backend.drawTiles(m_Instances, variant);
             }
+        }
+    }
 
-            SDL_FRect srcRect;
-            SDL_FRect destRect;
+    template <uint32_t Variant>
+    void Renderer::renderBucket(const std::vector<uint32_t>& bucket,
+                                const tmx::render::LayerRenderData& layer,
+                                const tmx::render::MapRenderData& renderData,
+                                const Camera& camera,
+                                const SDL_FRect& view)
+    {
+        for (const uint32_t index : bucket)
+        {
+            const auto& tile = layer.tiles[index];
 
-            if (tile.isAnimated && tile.animationIndex != static_cast<uint32_t>(-1))
+            // Cull tiles outside the camera view
+            const SDL_FRect worldRect = {
+                static_cast<float>(tile.destX),
+                static_cast<float>(tile.destY),
+                static_cast<float>(tile.destW),
+                static_cast<float>(tile.destH)
+            };
+            if (!intersects(worldRect, view))
             {
-                // Get animation info
-                const auto& tilesetInfo = renderData.tilesets[tile.tilesetIndex];
-                if (tile.animationIndex >= tilesetInfo.animations.size())
-                {
-                    continue;
-                }
-
-                const auto& animation = tilesetInfo.animations[tile.animationIndex];
+                continue;
+            }
 
-                // Get or create animation state
-                auto& state = m_AnimationStates.getState(tile.tilesetIndex, tile.animationIndex);
+            SDL_FRect srcRect = {
+                static_cast<float>(tile.srcX),
+                static_cast<float>(tile.srcY),
+                static_cast<float>(tile.srcW),
+                static_cast<float>(tile.srcH)
+            };
 
-                // Update animation
-                state.elapsedTime += deltaTime;
+            if constexpr ((Variant & TILE_ANIMATED) != 0)
+            {
+                // Indices were validated in prepare()
+                const auto& animation = renderData.tilesets[tile.tilesetIndex].animations[tile.animationIndex];
+                const auto& state = m_AnimationStates.getState(tile.tilesetIndex, tile.animationIndex);
 
                 // Use flattened lookup to get current frame index - O(1) instead of O(n)
                 const uint32_t timeInCycle = state.elapsedTime % animation.totalDuration;
-                const uint32_t frameIndex = animation.getFrameIndexAtTime(timeInCycle);
-
-                // Use the current animation frame
-                const auto& frame = animation.frames[frameIndex];
-                srcRect = {
-                    static_cast<float>(frame.srcX),
-                    static_cast<float>(frame.srcY),
-                    static_cast<float>(tile.srcW),
-                    static_cast<float>(tile.srcH)
-                };
+                const auto& frame = animation.frames[animation.getFrameIndexAtTime(timeInCycle)];
+                srcRect.x = static_cast<float>(frame.srcX);
+                srcRect.y = static_cast<float>(frame.srcY);
             }
-            else
+
+            float opacity = 1.0f;
+            if constexpr ((Variant & TILE_TRANSLUCENT) != 0)
             {
-                // Static tile - use pre-calculated source rect
-                srcRect = {
-                    static_cast<float>(tile.srcX),
-                    static_cast<float>(tile.srcY),
-                    static_cast<float>(tile.srcW),
-                    static_cast<float>(tile.srcH)
-                };
+                opacity = tile.opacity;
             }
 
-            // Destination is always the same
-            destRect = {
-                static_cast<float>(tile.destX),
-                static_cast<float>(tile.destY),
-                static_cast<float>(tile.destW),
-                static_cast<float>(tile.destH)
-            };
-
-            // Apply opacity if not fully opaque
-            if (tile.opacity < 1.0f)
+            uint32_t flips = 0;
+            if constexpr ((Variant & TILE_FLIPPED) != 0)
             {
-                SDL_SetTextureAlphaModFloat(texture, tile.opacity);
+                flips = getTileFlips(tile);
             }
 
-            SDL_RenderTexture(m_SdlRenderer, texture, &srcRect, &destRect);
+            m_Instances.push_back({camera.toScreen(worldRect), srcRect, opacity, tile.tilesetIndex, flips, 0});
+        }
+    }
 
-            // Reset opacity
-            if (tile.opacity < 1.0f)
+    size_t Renderer::getMemoryUsage() const
+    {
+        size_t bytes = m_Layers.capacity() * sizeof(PreparedLayer) + m_Instances.capacity() * sizeof(TileInstance);
+        for (const auto& layer : m_Layers)
+        {
+            for (const auto& bucket : layer.buckets)
             {
-                SDL_SetTextureAlphaModFloat(texture, 1.0f);
+                bytes += bucket.capacity() * sizeof(uint32_t);
             }
         }
+        return bytes;
+    }
+
+    void Renderer::update(const uint32_t deltaTime)
+    {
+        // Advance every animation once per frame, independent of how many tiles share it
+        m_AnimationStates.update(deltaTime);
     }
 
     void Renderer::resetAnimations()
@@ -2,46 +2,113 @@
 #define THEELDERWOODHILL_RENDERER_H
 
 #include <SDL3/SDL_render.h>
+#include <array>
 #include <tmx/tmx.hpp>
 #include "Animation.hpp"
+#include "Camera.hpp"
+#include "TileBackend.hpp"
 
 namespace teh::map
 {
     /**
      * @brief Handles rendering of TMX maps with animation support
+     *
+     * Resolves culling and animation frames into TileInstances and hands them to a TileBackend.
+     * Tiles are bucketed by TileVariant at load time and each bucket is walked by a
+     * kernel specialized for that variant, so the per-tile loop carries no feature branches.
+     * Each bucket reaches the backend as its own batch tagged with the variant.
      */
     class Renderer
     {
     public:
-        explicit Renderer(SDL_Renderer* sdlRenderer);
+        explicit Renderer(TileBackend& backend);
         ~Renderer();
 
+        /**
+         * @brief Bucket the tiles of every layer by variant
+         *
+         * Must be called whenever the render data changes. Tiles referencing a missing
+         * tileset or animation are dropped here instead of being checked every frame.
+         * @param renderData Pre-calculated render data from tmxparser
+         * @param transforms Offset and parallax per render layer, identity if empty
+         */
+        void prepare(const tmx::render::MapRenderData& renderData,
+                     const std::vector<LayerTransform>& transforms = {});
+
         /**
          * @brief Render the entire map with animations
          * @param renderData Pre-calculated render data from tmxparser
-         * @param tilesetTextures Vector of loaded tileset textures
+         * @param camera View used to place and cull tiles
          * @param deltaTime Time elapsed since last frame in milliseconds
          */
         void render(const tmx::render::MapRenderData& renderData,
-                   const std::vector<SDL_Texture*>& tilesetTextures,
+                   const Camera& camera,
                    uint32_t deltaTime);
 
+        /**
+         * @brief Advance animation clocks without drawing
+         * @param deltaTime Time elapsed since last frame in milliseconds
+         */
+        void update(uint32_t deltaTime);
+
+        /**
+         * @brief Access the shared animation clocks (e.g. to sync light flicker)
+         */
+        AnimationStateManager& getAnimationStates() { return m_AnimationStates; }
+        const AnimationStateManager& getAnimationStates() const { return m_AnimationStates; }
+
+        /**
+         * @brief Heap bytes held by the variant buckets and the instance list
+         */
+        size_t getMemoryUsage() const;
+
         /**
          * @brief Reset all animation states
          */
         void resetAnimations();
 
     private:
+        // Tile indices of one layer, one bucket per TileVariant
+        using LayerBuckets = std::array<std::vector<uint32_t>, TILE_VARIANT_COUNT>;
+
+        struct PreparedLayer
+        {
+            LayerBuckets buckets;
+            LayerTransform transform;
+        };
+
         /**
-         * @brief Render a single layer
+         * @brief Draw the visible tiles of a single layer, one backend batch per variant bucket
+         *
+         * Tiles are culled and placed through the layer's own camera.
          */
         void renderLayer(const tmx::render::LayerRenderData& layer,
+                        const PreparedLayer& prepared,
                         const tmx::render::MapRenderData& renderData,
-                        const std::vector<SDL_Texture*>& tilesetTextures,
-                        uint32_t deltaTime);
+                        const Camera& camera);
+
+        /**
+         * @brief Fill the instance list with the visible tiles of one bucket, specialized on its variant
+         */
+        template <uint32_t Variant>
+        void renderBucket(const std::vector<uint32_t>& bucket,
+                          const tmx::render::LayerRenderData& layer,
+                          const tmx::render::MapRenderData& renderData,
+                          const Camera& camera,
+                          const SDL_FRect& view);
+
+        using BucketKernel = void (Renderer::*)(const std::vector<uint32_t>&,
+                                                const tmx::render::LayerRenderData&,
+                                                const tmx::render::MapRenderData&,
+                                                const Camera&,
+                                                const SDL_FRect&);
+
+        static const std::array<BucketKernel, TILE_VARIANT_COUNT> s_Kernels;
 
-        SDL_Renderer* m_SdlRenderer;
+        TileBackend& m_Backend;
         AnimationStateManager m_AnimationStates;
+        std::vector<PreparedLayer> m_Layers;
+        std::vector<TileInstance> m_Instances;
     };
 } // namespace teh::map
 
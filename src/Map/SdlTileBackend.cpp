@@ -0,0 +1,192 @@
+#include "SdlTileBackend.hpp"
+#include "../Utils/Logger.hpp"
+
+namespace teh::map
+{
+    SdlTileBackend::SdlTileBackend(SDL_Renderer* sdlRenderer)
+        : m_SdlRenderer(sdlRenderer)
+    {
+    }
+
+    SdlTileBackend::~SdlTileBackend() = default;
+
+    SdlTilesetSet::~SdlTilesetSet()
+    {
+        for (auto* texture : m_Textures)
+        {
+            if (texture)
+            {
+                SDL_DestroyTexture(texture);
+            }
+        }
+    }
+
+    void SdlTilesetSet::getStats(std::vector<TextureStats>& stats) const
+    {
+        for (size_t i = 0; i < m_Textures.size(); ++i)
+        {
+            stats.push_back(TextureStats::fromTexture(m_Names[i], m_Textures[i]));
+        }
+    }
+
+    TilesetSet* SdlTileBackend::createTilesets(const tmx::render::MapRenderData& renderData, const TilesetImages& images)
+    {
+        if (images.size() != renderData.tilesets.size())
+        {
+            return nullptr;
+        }
+
+        auto* tilesets = new SdlTilesetSet();
+        for (size_t i = 0; i < renderData.tilesets.size(); ++i)
+        {
+            const auto& tileset = renderData.tilesets[i];
+            const auto& image = images[i];
+
+            TEH_MAP_LOG(DEBUG, "Uploading tileset {}: '{}' from {}", i, tileset.name, tileset.imagePath);
+
+            SDL_Texture* texture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                                     image.getWidth(), image.getHeight());
+            if (!texture || !SDL_UpdateTexture(texture, nullptr, image.getPixels(), image.getPitch()))
+            {
+                TEH_RESOURCE_LOG(ERROR, "Failed to create tileset texture: {} | SDL Error: {}", tileset.imagePath, SDL_GetError());
+                if (texture)
+                {
+                    SDL_DestroyTexture(texture);
+                }
+                delete tilesets;
+                return nullptr;
+            }
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+            TEH_RESOURCE_LOG(DEBUG, "Texture loaded successfully: {}", tileset.imagePath);
+            tilesets->m_Textures.push_back(texture);
+            tilesets->m_Names.push_back(tileset.name);
+        }
+
+        return tilesets;
+    }
+
+    void SdlTileBackend::beginFrame()
+    {
+        resetDrawCalls();
+        SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 255);
+        SDL_RenderClear(m_SdlRenderer);
+    }
+
+    void SdlTileBackend::drawTiles(std::span<const TileInstance> tiles, const uint32_t variant)
+    {
+        if (!m_Tilesets)
+        {
+            return;
+        }
+
+        const auto& textures = static_cast<const SdlTilesetSet*>(m_Tilesets)->getSdlTextures();
+
+        // The whole batch shares its layer's opacity, so fade the tilesets once around it
+        const bool translucent = (variant & TILE_TRANSLUCENT) != 0;
+        if (translucent)
+        {
+            for (auto* texture : textures)
+            {
+                setOpacity(texture, tiles.front().opacity);
+            }
+        }
+
+        if (variant & TILE_FLIPPED)
+        {
+            drawBatch<true>(tiles, textures);
+        }
+        else
+        {
+            drawBatch<false>(tiles, textures);
+        }
+
+        if (translucent)
+        {
+            for (auto* texture : textures)
+            {
+                setOpacity(texture, 1.0f);
+            }
+        }
+
+        m_DrawCalls += static_cast<uint32_t>(tiles.size());
+    }
+
+    template <bool Flipped>
+    void SdlTileBackend::drawBatch(const std::span<const TileInstance> tiles, const std::vector<SDL_Texture*>& textures)
+    {
+        for (const auto& tile : tiles)
+        {
+            if constexpr (Flipped)
+            {
+                renderFlippedTile(m_SdlRenderer, textures[tile.tilesetIndex], tile.src, tile.dst, tile.flags);
+            }
+            else
+            {
+                SDL_RenderTexture(m_SdlRenderer, textures[tile.tilesetIndex], &tile.src, &tile.dst);
+            }
+        }
+    }
+
+    void SdlTileBackend::setOpacity(SDL_Texture* texture, const float opacity)
+    {
+        // Premultiplied texels need their color scaled along with alpha
+        SDL_SetTextureColorModFloat(texture, opacity, opacity, opacity);
+        SDL_SetTextureAlphaModFloat(texture, opacity);
+    }
+
+    void SdlTileBackend::renderTile(SDL_Renderer* sdlRenderer, SDL_Texture* texture,
+                                    const SDL_FRect& src, const SDL_FRect& dst, const uint32_t flips)
+    {
+        if (flips == 0)
+        {
+            SDL_RenderTexture(sdlRenderer, texture, &src, &dst);
+            return;
+        }
+
+        renderFlippedTile(sdlRenderer, texture, src, dst, flips);
+    }
+
+    void SdlTileBackend::renderFlippedTile(SDL_Renderer* sdlRenderer, SDL_Texture* texture,
+                                           const SDL_FRect& src, const SDL_FRect& dst, const uint32_t flips)
+    {
+        if (!(flips & TILE_FLIP_DIAGONAL))
+        {
+            int mode = SDL_FLIP_NONE;
+            if (flips & TILE_FLIP_HORIZONTAL)
+                mode |= SDL_FLIP_HORIZONTAL;
+            if (flips & TILE_FLIP_VERTICAL)
+                mode |= SDL_FLIP_VERTICAL;
+
+            SDL_RenderTextureRotated(sdlRenderer, texture, &src, &dst, 0.0, nullptr, static_cast<SDL_FlipMode>(mode));
+            return;
+        }
+
+        // SDL flips before rotating: a diagonal flip is a vertical flip plus a 90° clockwise turn,
+        // and the turn swaps which axis the remaining horizontal/vertical flips act on
+        int mode = SDL_FLIP_NONE;
+        if (flips & TILE_FLIP_VERTICAL)
+            mode |= SDL_FLIP_HORIZONTAL;
+        if (!(flips & TILE_FLIP_HORIZONTAL))
+            mode |= SDL_FLIP_VERTICAL;
+
+        // Pre-rotation rect with swapped extents, so the turned quad covers dst
+        const SDL_FRect rotated = {
+            dst.x + (dst.w - dst.h) * 0.5f,
+            dst.y + (dst.h - dst.w) * 0.5f,
+            dst.h,
+            dst.w
+        };
+        SDL_RenderTextureRotated(sdlRenderer, texture, &src, &rotated, 90.0, nullptr, static_cast<SDL_FlipMode>(mode));
+    }
+
+    void SdlTileBackend::endFrame()
+    {
+        SDL_RenderPresent(m_SdlRenderer);
+    }
+
+    void SdlTileBackend::getOutputSize(int& width, int& height) const
+    {
+        SDL_GetCurrentRenderOutputSize(m_SdlRenderer, &width, &height);
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef THEELDERWOODHILL_SDLTILEBACKEND_HPP
+#define THEELDERWOODHILL_SDLTILEBACKEND_HPP
+
+#include "TileBackend.hpp"
+
+namespace teh::map
+{
+    /**
+     * @brief Tileset textures of one map on an SDL_Renderer
+     */
+    class SdlTilesetSet : public TilesetSet
+    {
+    public:
+        ~SdlTilesetSet() override;
+
+        void getStats(std::vector<TextureStats>& stats) const override;
+        const std::vector<SDL_Texture*>& getSdlTextures() const override { return m_Textures; }
+
+    private:
+        friend class SdlTileBackend;
+
+        std::vector<SDL_Texture*> m_Textures;
+        std::vector<std::string> m_Names;
+    };
+
+    /**
+     * @brief Tile backend on the SDL_Renderer 2D API, one SDL_RenderTexture per tile
+     *
+     * Opacity is applied once per translucent batch; unflipped batches go straight to SDL_RenderTexture.
+     */
+    class SdlTileBackend : public TileBackend
+    {
+    public:
+        explicit SdlTileBackend(SDL_Renderer* sdlRenderer);
+        ~SdlTileBackend() override;
+
+        SdlTileBackend(const SdlTileBackend&) = delete;
+        SdlTileBackend& operator=(const SdlTileBackend&) = delete;
+
+        const char* getName() const override { return "SDL_Renderer"; }
+
+        TilesetSet* createTilesets(const tmx::render::MapRenderData& renderData, const TilesetImages& images) override;
+
+        void beginFrame() override;
+        void drawTiles(std::span<const TileInstance> tiles, uint32_t variant) override;
+        void endFrame() override;
+
+        void getOutputSize(int& width, int& height) const override;
+
+        SDL_Renderer* getSdlRenderer() const override { return m_SdlRenderer; }
+
+        /**
+         * @brief Fade a premultiplied tileset texture for the following draws
+         */
+        static void setOpacity(SDL_Texture* texture, float opacity);
+
+        /**
+         * @brief Draw one tile quad, applying TileFlip bits with SDL_RenderTextureRotated
+         */
+        static void renderTile(SDL_Renderer* sdlRenderer, SDL_Texture* texture,
+                               const SDL_FRect& src, const SDL_FRect& dst, uint32_t flips);
+
+        /**
+         * @brief renderTile() for a tile known to carry at least one TileFlip bit
+         */
+        static void renderFlippedTile(SDL_Renderer* sdlRenderer, SDL_Texture* texture,
+                                      const SDL_FRect& src, const SDL_FRect& dst, uint32_t flips);
+
+    private:
+        /**
+         * @brief Issue one draw per tile, specialized on whether the batch is flipped
+         */
+        template <bool Flipped>
+        void drawBatch(std::span<const TileInstance> tiles, const std::vector<SDL_Texture*>& textures);
+
+        SDL_Renderer* m_SdlRenderer;
+    };
+}
+
+#endif //THEELDERWOODHILL_SDLTILEBACKEND_HPP
@@ -0,0 +1,66 @@
+#include "Telemetry.hpp"
+#include "../Utils/Logger.hpp"
+
+namespace teh::map
+{
+    static double toMiB(const size_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    TextureStats TextureStats::fromTexture(std::string name, const SDL_Texture* texture)
+    {
+        TextureStats stats;
+        stats.name = std::move(name);
+        if (texture)
+        {
+            stats.width = texture->w;
+            stats.height = texture->h;
+            stats.bytesPerPixel = SDL_BYTESPERPIXEL(texture->format);
+        }
+        return stats;
+    }
+
+    void MapStats::log() const
+    {
+        TEH_PERF_LOG(INFO, "Map memory: CPU {:.2f} MiB | GPU {:.2f} MiB", toMiB(getCpuBytes()), toMiB(getGpuBytes()));
+        TEH_PERF_LOG(INFO, "  render data {:.2f} MiB | renderer {:.2f} MiB | objects {:.2f} MiB | {} animation states",
+                     toMiB(renderDataBytes), toMiB(rendererBytes), toMiB(objectBytes), animationStates);
+
+        for (const auto& tileset : tilesets)
+        {
+            TEH_PERF_LOG(INFO, "  tileset '{}': {}x{} x {} B = {:.2f} MiB",
+                         tileset.name, tileset.width, tileset.height, tileset.bytesPerPixel, toMiB(tileset.getBytes()));
+        }
+
+        TEH_PERF_LOG(INFO, "  overview: {} regions, {} chunks", overviewRegions, overviewChunks);
+        for (size_t level = 0; level < residentChunks.size(); ++level)
+        {
+            TEH_PERF_LOG(INFO, "  overview level {}: {}/{} chunks resident", level + 1, residentChunks[level], overviewChunks);
+        }
+
+        TEH_PERF_LOG(INFO, "  textures: tilesets {:.2f} MiB | overview {:.2f} MiB | lighting {:.2f} MiB ({} lights)",
+                     toMiB(tilesetBytes), toMiB(overviewBytes), toMiB(lightingBytes), lightCount);
+    }
+
+    size_t getRenderDataBytes(const tmx::render::MapRenderData& renderData)
+    {
+        size_t bytes = sizeof(renderData);
+
+        for (const auto& tileset : renderData.tilesets)
+        {
+            bytes += sizeof(tileset) + tileset.name.capacity() + tileset.imagePath.capacity();
+            for (const auto& animation : tileset.animations)
+            {
+                bytes += sizeof(animation) + animation.frames.capacity() * sizeof(tmx::render::AnimationFrame);
+            }
+        }
+
+        for (const auto& layer : renderData.layers)
+        {
+            bytes += sizeof(layer) + layer.name.capacity() + layer.tiles.capacity() * sizeof(tmx::render::TileRenderData);
+        }
+
+        return bytes;
+    }
+}
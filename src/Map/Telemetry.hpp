@@ -0,0 +1,69 @@
+#ifndef THEELDERWOODHILL_TELEMETRY_HPP
+#define THEELDERWOODHILL_TELEMETRY_HPP
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+namespace teh::map
+{
+    /**
+     * @brief Size of one texture resident on the GPU
+     */
+    struct TextureStats
+    {
+        std::string name;
+        int width{};
+        int height{};
+        int bytesPerPixel{};
+
+        size_t getBytes() const { return static_cast<size_t>(width) * height * bytesPerPixel; }
+
+        /**
+         * @brief Read the dimensions and pixel format of an SDL texture
+         */
+        static TextureStats fromTexture(std::string name, const SDL_Texture* texture);
+    };
+
+    /**
+     * @brief Memory and resource footprint of a loaded map
+     *
+     * CPU figures count container capacity, so they include slack but not allocator overhead.
+     */
+    struct MapStats
+    {
+        // CPU
+        size_t renderDataBytes{};       // tmxparser render data: layers, tiles, tilesets, animations
+        size_t rendererBytes{};         // Variant buckets and the per-frame instance list
+        size_t objectBytes{};           // Object store and its spatial grid
+        size_t animationStates{};       // Live animation clocks
+
+        // GPU
+        std::vector<TextureStats> tilesets;
+        size_t tilesetBytes{};
+        uint32_t overviewRegions{};     // Runs of layers sharing one offset and parallax
+        uint32_t overviewChunks{};
+        std::vector<uint32_t> residentChunks;   // Baked chunk textures per overview level, level 1 first
+        size_t overviewBytes{};
+        size_t lightCount{};
+        size_t lightingBytes{};
+
+        size_t getCpuBytes() const { return renderDataBytes + rendererBytes + objectBytes; }
+        size_t getGpuBytes() const { return tilesetBytes + overviewBytes + lightingBytes; }
+
+        /**
+         * @brief Dump the statistics through the PERFORMANCE log category
+         */
+        void log() const;
+    };
+
+    /**
+     * @brief Approximate heap footprint of tmxparser render data
+     */
+    size_t getRenderDataBytes(const tmx::render::MapRenderData& renderData);
+}
+
+#endif //THEELDERWOODHILL_TELEMETRY_HPP
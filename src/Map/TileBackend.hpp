@@ -0,0 +1,224 @@
+#ifndef THEELDERWOODHILL_TILEBACKEND_HPP
+#define THEELDERWOODHILL_TILEBACKEND_HPP
+
+#include <SDL3/SDL.h>
+#include <span>
+#include <vector>
+#include <tmx/tmx.hpp>
+#include "Telemetry.hpp"
+#include "../Utils/TextureCache.hpp"
+
+namespace teh::map
+{
+    /**
+     * @brief Tiled flip bits carried in TileInstance::flags
+     *
+     * Tiled applies the diagonal flip (swap x and y) first, then horizontal, then vertical.
+     */
+    enum TileFlip : uint32_t
+    {
+        TILE_FLIP_HORIZONTAL = 1 << 0,
+        TILE_FLIP_VERTICAL = 1 << 1,
+        TILE_FLIP_DIAGONAL = 1 << 2
+    };
+
+    /**
+     * @brief Per-tile features that select a specialized draw kernel
+     */
+    enum TileVariant : uint32_t
+    {
+        TILE_FLIPPED = 1 << 0,
+        TILE_TRANSLUCENT = 1 << 1,
+        TILE_ANIMATED = 1 << 2,
+        TILE_VARIANT_COUNT = 1 << 3
+    };
+
+    /**
+     * @brief Collect the flip bits tmxparser decoded from a tile's GID
+     */
+    inline uint32_t getTileFlips(const tmx::render::TileRenderData& tile)
+    {
+        return (tile.flipHorizontal ? TILE_FLIP_HORIZONTAL : 0u)
+             | (tile.flipVertical ? TILE_FLIP_VERTICAL : 0u)
+             | (tile.flipDiagonal ? TILE_FLIP_DIAGONAL : 0u);
+    }
+
+    /**
+     * @brief One resolved tile quad, ready for submission
+     *
+     * Laid out to match the std430 instance struct of the GPU tile shader.
+     */
+    struct TileInstance
+    {
+        SDL_FRect dst;          // Screen-space destination
+        SDL_FRect src;          // Source rect in tileset pixels
+        float opacity;
+        uint32_t tilesetIndex;
+        uint32_t flags;         // TileFlip bits
+        uint32_t padding;
+    };
+    static_assert(sizeof(TileInstance) == 48, "TileInstance must match the shader instance layout");
+
+    /**
+     * @brief Decoded tileset images of one map; image i matches renderData.tilesets[i]
+     */
+    using TilesetImages = std::vector<utils::TextureCache::Image>;
+
+    /**
+     * @brief Tileset textures of one map, created by a TileBackend
+     *
+     * Several maps can keep their tilesets resident at once. The backend draws
+     * from the set bound with TileBackend::bindTilesets(). Destroy on the main thread.
+     */
+    class TilesetSet
+    {
+    public:
+        virtual ~TilesetSet() = default;
+
+        /**
+         * @brief Append the GPU footprint of each tileset
+         */
+        virtual void getStats(std::vector<TextureStats>& stats) const = 0;
+
+        /**
+         * @brief Tileset textures usable with TileBackend::getSdlRenderer(), empty if the backend has none
+         */
+        virtual const std::vector<SDL_Texture*>& getSdlTextures() const
+        {
+            static const std::vector<SDL_Texture*> none;
+            return none;
+        }
+    };
+
+    /**
+     * @brief Graphics API used to draw tiles
+     *
+     * Uploads tileset images and owns the frame: the Renderer resolves animation and
+     * culling into TileInstances and the backend turns them into draw calls.
+     */
+    class TileBackend
+    {
+    public:
+        virtual ~TileBackend() = default;
+
+        /**
+         * @brief Human readable backend name for logs
+         */
+        virtual const char* getName() const = 0;
+
+        /**
+         * @brief Use a decoded-image cache for tileset loading; nullptr decodes every time
+         */
+        void setTextureCache(utils::TextureCache* textureCache) { m_TextureCache = textureCache; }
+
+        /**
+         * @brief Decode every tileset image of a map into premultiplied RGBA32 pixels
+         *
+         * Touches no graphics state, so it may run on a loader thread.
+         * @return true if all images were decoded
+         */
+        bool decodeTilesets(const tmx::render::MapRenderData& renderData, TilesetImages& images) const
+        {
+            images = TilesetImages(renderData.tilesets.size());
+            for (size_t i = 0; i < renderData.tilesets.size(); ++i)
+            {
+                if (!loadImage(renderData.tilesets[i].imagePath, images[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Upload decoded tileset images; texture i matches renderData.tilesets[i]
+         * @return The new set, owned by the caller, or nullptr on failure
+         */
+        virtual TilesetSet* createTilesets(const tmx::render::MapRenderData& renderData, const TilesetImages& images) = 0;
+
+        /**
+         * @brief GPU bytes createTilesets() will allocate for these images
+         *
+         * Touches no graphics state, so it may run on a loader thread.
+         */
+        virtual size_t getTilesetBytes(const TilesetImages& images) const
+        {
+            size_t bytes = 0;
+            for (const auto& image : images)
+            {
+                bytes += static_cast<size_t>(image.getWidth()) * image.getHeight() * 4;
+            }
+            return bytes;
+        }
+
+        /**
+         * @brief Select the tilesets the following drawTiles() calls refer to
+         */
+        void bindTilesets(const TilesetSet* tilesets) { m_Tilesets = tilesets; }
+        const TilesetSet* getBoundTilesets() const { return m_Tilesets; }
+
+        /**
+         * @brief Start a frame and clear the output
+         */
+        virtual void beginFrame() = 0;
+
+        /**
+         * @brief Draw one bucket of tiles in order, on top of everything drawn before in this frame
+         *
+         * All tiles share the TileVariant bits. A translucent batch comes from a single
+         * layer, so every tile carries the same opacity. Tileset indices were validated
+         * against the bound set by Renderer::prepare().
+         */
+        virtual void drawTiles(std::span<const TileInstance> tiles, uint32_t variant) = 0;
+
+        /**
+         * @brief Finish and present the frame
+         */
+        virtual void endFrame() = 0;
+
+        /**
+         * @brief Get the output size in pixels
+         */
+        virtual void getOutputSize(int& width, int& height) const = 0;
+
+        /**
+         * @brief Count draw calls issued outside the backend into the current frame
+         */
+        void addDrawCalls(uint32_t count) { m_DrawCalls += count; }
+
+        /**
+         * @brief Draw calls of the last completed frame
+         */
+        uint32_t getDrawCalls() const { return m_LastDrawCalls; }
+
+        /**
+         * @brief SDL_Renderer for passes built on the 2D API (overview, lighting, UI), or nullptr
+         */
+        virtual SDL_Renderer* getSdlRenderer() const { return nullptr; }
+
+    protected:
+        /**
+         * @brief Load premultiplied RGBA32 tileset pixels, through the texture cache if one is set
+         */
+        bool loadImage(const std::string& imagePath, utils::TextureCache::Image& image) const
+        {
+            return m_TextureCache ? m_TextureCache->load(imagePath, image) : utils::TextureCache::decode(imagePath, image);
+        }
+
+        /**
+         * @brief Close the draw call count of the frame; backends call this from beginFrame()
+         */
+        void resetDrawCalls()
+        {
+            m_LastDrawCalls = m_DrawCalls;
+            m_DrawCalls = 0;
+        }
+
+        utils::TextureCache* m_TextureCache{};
+        const TilesetSet* m_Tilesets{};
+        uint32_t m_DrawCalls{};
+        uint32_t m_LastDrawCalls{};
+    };
+}
+
+#endif //THEELDERWOODHILL_TILEBACKEND_HPP
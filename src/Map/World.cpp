@@ -0,0 +1,447 @@
+#include "World.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+
+namespace teh::map
+{
+    namespace
+    {
+        float toMiB(const size_t bytes)
+        {
+            return static_cast<float>(bytes) / (1024.0f * 1024.0f);
+        }
+
+        bool contains(const SDL_FRect& rect, const SDL_FPoint& point)
+        {
+            return point.x >= rect.x && point.x < rect.x + rect.w && point.y >= rect.y && point.y < rect.y + rect.h;
+        }
+
+        /**
+         * @brief Gap between two rects along the axis where it is largest, 0 if they overlap
+         */
+        float getDistance(const SDL_FRect& a, const SDL_FRect& b)
+        {
+            const float gapX = std::max(a.x - (b.x + b.w), b.x - (a.x + a.w));
+            const float gapY = std::max(a.y - (b.y + b.h), b.y - (a.y + a.h));
+            return std::max({gapX, gapY, 0.0f});
+        }
+    }
+
+    World::World(TileBackend& backend)
+        : m_Backend(backend)
+    {
+        m_Loader = std::thread(&World::loaderLoop, this);
+    }
+
+    World::~World()
+    {
+        {
+            std::lock_guard lock(m_LoaderMutex);
+            m_StopLoader = true;
+        }
+        m_RequestReady.notify_all();
+        m_Loader.join();
+
+        for (const auto& prepared : m_Prepared)
+        {
+            delete prepared.map;
+        }
+        for (auto& entry : m_Entries)
+        {
+            delete entry.map;
+        }
+    }
+
+    bool World::addMap(const std::string& name, const std::string& filePath, const SDL_FRect& area)
+    {
+        if (find(name) != NONE)
+        {
+            TEH_MAP_LOG(ERROR, "Map '{}' is already part of the world", name);
+            return false;
+        }
+
+        Entry entry;
+        entry.name = name;
+        entry.filePath = filePath;
+        entry.area = area;
+        m_Entries.push_back(std::move(entry));
+        return true;
+    }
+
+    bool World::link(const std::string& first, const std::string& second)
+    {
+        const uint32_t a = find(first);
+        const uint32_t b = find(second);
+        if (a == NONE || b == NONE || a == b)
+        {
+            TEH_MAP_LOG(ERROR, "Cannot link maps '{}' and '{}'", first, second);
+            return false;
+        }
+
+        auto& neighboursA = m_Entries[a].neighbours;
+        if (std::ranges::find(neighboursA, b) == neighboursA.end())
+        {
+            neighboursA.push_back(b);
+            m_Entries[b].neighbours.push_back(a);
+        }
+        return true;
+    }
+
+    bool World::enter(const std::string& name)
+    {
+        const uint32_t index = find(name);
+        if (index == NONE)
+        {
+            TEH_MAP_LOG(ERROR, "Unknown map '{}'", name);
+            return false;
+        }
+
+        // Loads go through the loader thread even here, so tileset decoding never runs twice at once
+        if (m_Entries[index].state == EntryState::Unloaded || m_Entries[index].state == EntryState::Loading)
+        {
+            request(index, true);
+            finalizePrepared(index, index);
+        }
+
+        auto& entry = m_Entries[index];
+        if (entry.state != EntryState::Resident)
+        {
+            return false;
+        }
+
+        m_Current = index;
+        entry.lastUsed = ++m_Clock;
+        TEH_MAP_LOG(INFO, "Entered map '{}'", entry.name);
+
+        enforceBudget();
+        return true;
+    }
+
+    bool World::update(const Camera& camera)
+    {
+        m_Clock++;
+
+        if (m_Current == NONE)
+        {
+            finalizePrepared(NONE, NONE);
+            return false;
+        }
+
+        const SDL_FRect view = camera.getWorldRect();
+        const SDL_FPoint center = {view.x + view.w * 0.5f, view.y + view.h * 0.5f};
+
+        auto& current = m_Entries[m_Current];
+        current.lastUsed = m_Clock;
+
+        // Neighbours in reach count as in use, so eviction picks maps far behind first
+        for (const uint32_t index : current.neighbours)
+        {
+            auto& neighbour = m_Entries[index];
+            if (getDistance(view, neighbour.area) > m_PreloadDistance)
+            {
+                neighbour.evictedNearby = false;
+                continue;
+            }
+
+            if (neighbour.state == EntryState::Resident)
+            {
+                neighbour.lastUsed = m_Clock;
+            }
+            else if (neighbour.state == EntryState::Unloaded && !neighbour.evictedNearby)
+            {
+                request(index, false);
+            }
+        }
+
+        // Neighbour under the view center, the one map allowed to push others in reach out of memory
+        uint32_t target = NONE;
+        if (!contains(current.area, center))
+        {
+            const auto it = std::ranges::find_if(current.neighbours, [&](const uint32_t index) {
+                return contains(m_Entries[index].area, center);
+            });
+            target = it == current.neighbours.end() ? NONE : *it;
+        }
+
+        // After the marking above, so the budget check knows which maps are still in reach
+        finalizePrepared(NONE, target);
+
+        bool changed = false;
+        if (target != NONE)
+        {
+            auto& neighbour = m_Entries[target];
+            if (neighbour.state == EntryState::Resident)
+            {
+                TEH_MAP_LOG(INFO, "Crossed from map '{}' into '{}'", current.name, neighbour.name);
+                m_Current = target;
+                neighbour.lastUsed = m_Clock;
+                changed = true;
+            }
+            else if (neighbour.state == EntryState::Unloaded || neighbour.state == EntryState::Loading)
+            {
+                // Preload missed it (budget or a fast camera); keep showing the current map meanwhile
+                request(target, true);
+            }
+        }
+
+        enforceBudget();
+        return changed;
+    }
+
+    void World::render(const Camera& camera, const uint32_t deltaTime)
+    {
+        if (Map* map = getCurrentMap())
+        {
+            map->render(toMapCamera(camera), deltaTime);
+        }
+    }
+
+    Camera World::toMapCamera(const Camera& camera) const
+    {
+        Camera mapCamera = camera;
+        if (m_Current != NONE)
+        {
+            mapCamera.x -= m_Entries[m_Current].area.x;
+            mapCamera.y -= m_Entries[m_Current].area.y;
+        }
+        return mapCamera;
+    }
+
+    size_t World::getResidentBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& entry : m_Entries)
+        {
+            if (entry.state == EntryState::Resident)
+            {
+                bytes += entry.bytes;
+            }
+        }
+        return bytes;
+    }
+
+    uint32_t World::getResidentCount() const
+    {
+        return static_cast<uint32_t>(std::ranges::count(m_Entries, EntryState::Resident, &Entry::state));
+    }
+
+    uint32_t World::find(const std::string& name) const
+    {
+        const auto it = std::ranges::find(m_Entries, name, &Entry::name);
+        return it == m_Entries.end() ? NONE : static_cast<uint32_t>(it - m_Entries.begin());
+    }
+
+    void World::request(const uint32_t index, const bool urgent)
+    {
+        auto& entry = m_Entries[index];
+        {
+            std::lock_guard lock(m_LoaderMutex);
+
+            const auto queued = std::ranges::find(m_Requests, index, &Request::index);
+            if (queued != m_Requests.end())
+            {
+                // Already waiting, only the priority can change
+                if (urgent && queued != m_Requests.begin())
+                {
+                    Request moved = std::move(*queued);
+                    m_Requests.erase(queued);
+                    m_Requests.push_front(std::move(moved));
+                }
+                return;
+            }
+
+            // Being prepared or waiting for finalize
+            if (entry.state == EntryState::Loading)
+            {
+                return;
+            }
+
+            if (urgent)
+            {
+                m_Requests.push_front({index, entry.filePath});
+            }
+            else
+            {
+                m_Requests.push_back({index, entry.filePath});
+            }
+        }
+
+        entry.state = EntryState::Loading;
+        m_RequestReady.notify_one();
+        TEH_MAP_LOG(DEBUG, "Queued map '{}' for loading{}", entry.name, urgent ? " (urgent)" : "");
+    }
+
+    bool World::finalizePrepared(const uint32_t index, const uint32_t needed)
+    {
+        Prepared prepared{};
+        {
+            std::unique_lock lock(m_LoaderMutex);
+            if (index != NONE)
+            {
+                m_PreparedReady.wait(lock, [&] {
+                    return std::ranges::find(m_Prepared, index, &Prepared::index) != m_Prepared.end();
+                });
+            }
+
+            const auto it = index == NONE ? m_Prepared.begin() : std::ranges::find(m_Prepared, index, &Prepared::index);
+            if (it == m_Prepared.end())
+            {
+                return false;
+            }
+            prepared = *it;
+            m_Prepared.erase(it);
+        }
+
+        auto& entry = m_Entries[prepared.index];
+
+        // Settle the budget before uploading, so a map is never finalized only to be evicted again
+        if (prepared.map->isPrepared())
+        {
+            const size_t estimate = prepared.map->getMemoryUsage();
+            if (!makeRoom(estimate, prepared.index == needed))
+            {
+                TEH_MAP_LOG(INFO, "Dropping preload of map '{}': {:.2f} MiB does not fit the budget next to the maps in reach",
+                            entry.name, toMiB(estimate));
+                delete prepared.map;
+                entry.state = EntryState::Unloaded;
+                entry.evictedNearby = true;
+                return true;
+            }
+        }
+
+        if (!prepared.map->isPrepared() || !prepared.map->finalize())
+        {
+            TEH_MAP_LOG(ERROR, "Failed to load map '{}' from {}", entry.name, entry.filePath);
+            delete prepared.map;
+            entry.state = EntryState::Failed;
+            return true;
+        }
+
+        entry.map = prepared.map;
+        entry.state = EntryState::Resident;
+        entry.bytes = entry.map->getMemoryUsage();
+        entry.lastUsed = m_Clock;
+        if (entry.area.w <= 0.0f || entry.area.h <= 0.0f)
+        {
+            entry.area.w = static_cast<float>(entry.map->getPixelWidth());
+            entry.area.h = static_cast<float>(entry.map->getPixelHeight());
+        }
+
+        TEH_MAP_LOG(INFO, "Map '{}' resident: {:.2f} MiB, {} maps use {:.2f} of {:.2f} MiB",
+                    entry.name, toMiB(entry.bytes), getResidentCount(), toMiB(getResidentBytes()), toMiB(m_MemoryBudget));
+        return true;
+    }
+
+    void World::evict(const uint32_t index)
+    {
+        auto& entry = m_Entries[index];
+        TEH_MAP_LOG(INFO, "Evicting map '{}' ({:.2f} MiB)", entry.name, toMiB(entry.bytes));
+
+        delete entry.map;
+        entry.map = nullptr;
+        entry.bytes = 0;
+        entry.state = EntryState::Unloaded;
+
+        // Only maps still in reach would be requested again right away
+        entry.evictedNearby = entry.lastUsed == m_Clock;
+    }
+
+    uint32_t World::findVictim(const bool allowInReach) const
+    {
+        // The current map always stays, even if it alone exceeds the budget
+        uint32_t victim = NONE;
+        for (uint32_t i = 0; i < m_Entries.size(); ++i)
+        {
+            const auto& entry = m_Entries[i];
+            if (i == m_Current || entry.state != EntryState::Resident || (!allowInReach && entry.lastUsed == m_Clock))
+            {
+                continue;
+            }
+            if (victim == NONE || entry.lastUsed < m_Entries[victim].lastUsed)
+            {
+                victim = i;
+            }
+        }
+        return victim;
+    }
+
+    bool World::makeRoom(const size_t bytes, const bool needed)
+    {
+        // A preload may only displace maps out of reach, and only if that is enough
+        size_t total = getResidentBytes();
+        if (!needed)
+        {
+            size_t reclaimable = 0;
+            for (uint32_t i = 0; i < m_Entries.size(); ++i)
+            {
+                const auto& entry = m_Entries[i];
+                if (i != m_Current && entry.state == EntryState::Resident && entry.lastUsed != m_Clock)
+                {
+                    reclaimable += entry.bytes;
+                }
+            }
+
+            if (total - reclaimable + bytes > m_MemoryBudget)
+            {
+                return false;
+            }
+        }
+
+        while (total + bytes > m_MemoryBudget)
+        {
+            const uint32_t victim = findVictim(needed);
+            if (victim == NONE)
+            {
+                // Only the current map is left; a needed map loads over budget rather than not at all
+                break;
+            }
+
+            total -= m_Entries[victim].bytes;
+            evict(victim);
+        }
+        return true;
+    }
+
+    void World::enforceBudget()
+    {
+        // Uploads already made room for themselves; this only trims maps that fell out of reach.
+        // Evicting one still in reach would just bring it back as an urgent load at the seam.
+        size_t total = getResidentBytes();
+        while (total > m_MemoryBudget)
+        {
+            const uint32_t victim = findVictim(false);
+            if (victim == NONE)
+            {
+                break;
+            }
+
+            total -= m_Entries[victim].bytes;
+            evict(victim);
+        }
+    }
+
+    void World::loaderLoop()
+    {
+        std::unique_lock lock(m_LoaderMutex);
+        while (true)
+        {
+            m_RequestReady.wait(lock, [this] { return m_StopLoader || !m_Requests.empty(); });
+            if (m_StopLoader)
+            {
+                return;
+            }
+
+            Request next = std::move(m_Requests.front());
+            m_Requests.pop_front();
+            lock.unlock();
+
+            // A failed prepare is still handed over, the main thread reports it
+            auto* map = new Map(m_Backend);
+            map->prepare(next.filePath);
+
+            lock.lock();
+            m_Prepared.push_back({next.index, map});
+            m_PreparedReady.notify_all();
+        }
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef THEELDERWOODHILL_WORLD_HPP
+#define THEELDERWOODHILL_WORLD_HPP
+
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Camera.hpp"
+#include "Map.hpp"
+
+namespace teh::map
+{
+    /**
+     * @brief Several maps placed side by side, loaded around the view
+     *
+     * Maps are registered with the world-space area they cover, like the maps of a
+     * Tiled .world file, and linked to their neighbours. While the view is close to
+     * a neighbour, a loader thread runs Map::prepare() for it and update() finalizes
+     * it on the main thread, so by the time the view crosses over, switching maps
+     * is a pointer swap. Room in the memory budget is made before a map is uploaded,
+     * evicting least recently used maps first; a preload that would only fit by
+     * evicting maps still in reach is dropped until the view comes back.
+     *
+     * All methods are main thread only.
+     */
+    class World
+    {
+    public:
+        static constexpr float DEFAULT_PRELOAD_DISTANCE = 512.0f;
+        static constexpr size_t DEFAULT_MEMORY_BUDGET = size_t{512} << 20;
+
+        explicit World(TileBackend& backend);
+        ~World();
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        /**
+         * @brief Register a map
+         * @param name Unique name used by link() and enter()
+         * @param filePath Path to the .tmx file
+         * @param area World-space rect covered by the map, its tile origin at area.x, area.y.
+         *             A zero size is filled in from the map's pixel size once it is loaded.
+         * @return false if the name is already taken
+         */
+        bool addMap(const std::string& name, const std::string& filePath, const SDL_FRect& area);
+
+        /**
+         * @brief Make two maps neighbours of each other
+         * @return false if either map is unknown
+         */
+        bool link(const std::string& first, const std::string& second);
+
+        /**
+         * @brief Make a map current, loading it first if needed
+         *
+         * Blocks until the map is loaded; meant for the start map and teleports.
+         * Walking between neighbours goes through update() instead.
+         * @return true if the map is now current
+         */
+        bool enter(const std::string& name);
+
+        /**
+         * @brief Per-frame bookkeeping
+         *
+         * Finalizes at most one map prepared in the background, requests neighbours
+         * near the view, switches to the neighbour under the view center when it is
+         * resident and enforces the memory budget.
+         * @param camera World-space view
+         * @return true if the current map changed
+         */
+        bool update(const Camera& camera);
+
+        /**
+         * @brief Render the current map
+         * @param camera World-space view
+         * @param deltaTime Time elapsed since last frame in milliseconds
+         */
+        void render(const Camera& camera, uint32_t deltaTime);
+
+        /**
+         * @brief Current map, or nullptr before the first enter()
+         */
+        Map* getCurrentMap() const { return m_Current == NONE ? nullptr : m_Entries[m_Current].map; }
+
+        /**
+         * @brief Convert a world-space camera into the current map's tile space
+         */
+        Camera toMapCamera(const Camera& camera) const;
+
+        void setMemoryBudget(size_t bytes) { m_MemoryBudget = bytes; }
+        size_t getMemoryBudget() const { return m_MemoryBudget; }
+
+        /**
+         * @brief Distance between the view and a neighbour's area below which it gets loaded
+         */
+        void setPreloadDistance(float distance) { m_PreloadDistance = distance; }
+
+        /**
+         * @brief Memory held by finalized maps, as measured when each was finalized
+         */
+        size_t getResidentBytes() const;
+        uint32_t getResidentCount() const;
+
+    private:
+        static constexpr uint32_t NONE = static_cast<uint32_t>(-1);
+
+        enum class EntryState : uint8_t
+        {
+            Unloaded,
+            Loading,        // Queued, being prepared or waiting for finalize
+            Resident,
+            Failed          // Not retried
+        };
+
+        struct Entry
+        {
+            std::string name;
+            std::string filePath;
+            SDL_FRect area{};
+            std::vector<uint32_t> neighbours;
+            Map* map{};
+            size_t bytes{};
+            uint64_t lastUsed{};
+            EntryState state{EntryState::Unloaded};
+            bool evictedNearby{};   // Evicted while in preload range; wait for the view to leave first
+        };
+
+        struct Request
+        {
+            uint32_t index;
+            std::string filePath;
+        };
+
+        struct Prepared
+        {
+            uint32_t index;
+            Map* map;
+        };
+
+        uint32_t find(const std::string& name) const;
+
+        /**
+         * @brief Queue a map for the loader thread
+         * @param urgent Put it ahead of pending preloads
+         */
+        void request(uint32_t index, bool urgent);
+
+        /**
+         * @brief Finalize one prepared map, making room in the budget before the upload
+         *
+         * A preload that only fits by evicting maps in reach is dropped instead.
+         * @param index Map to wait for, or NONE to take whatever is ready without waiting
+         * @param needed Map the view needs now; it may evict maps in reach and exceed the budget
+         * @return true if a map was taken off the loader
+         */
+        bool finalizePrepared(uint32_t index, uint32_t needed);
+
+        /**
+         * @brief Least recently used resident map other than the current one, or NONE
+         * @param allowInReach Also consider maps used this frame
+         */
+        uint32_t findVictim(bool allowInReach) const;
+
+        /**
+         * @brief Evict least recently used maps until bytes more fit the budget
+         * @param needed Evict maps in reach too, and succeed even if the budget stays exceeded
+         * @return false if nothing was evicted because the bytes cannot fit
+         */
+        bool makeRoom(size_t bytes, bool needed);
+
+        void evict(uint32_t index);
+
+        /**
+         * @brief Evict maps out of reach, least recently used first, while over budget
+         */
+        void enforceBudget();
+
+        void loaderLoop();
+
+        TileBackend& m_Backend;
+        std::vector<Entry> m_Entries;
+        uint32_t m_Current{NONE};
+        uint64_t m_Clock{};
+        size_t m_MemoryBudget{DEFAULT_MEMORY_BUDGET};
+        float m_PreloadDistance{DEFAULT_PRELOAD_DISTANCE};
+
+        // Shared with the loader thread
+        std::mutex m_LoaderMutex;
+        std::condition_variable m_RequestReady;
+        std::condition_variable m_PreparedReady;
+        std::deque<Request> m_Requests;
+        std::vector<Prepared> m_Prepared;
+        bool m_StopLoader{};
+
+        std::thread m_Loader;
+    };
+}
+
+#endif //THEELDERWOODHILL_WORLD_HPP
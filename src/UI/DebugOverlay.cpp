@@ -0,0 +1,79 @@
+#include "DebugOverlay.hpp"
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace teh::ui
+{
+    static constexpr float MARGIN = 10.0f;
+    static constexpr float PADDING = 4.0f;
+    static constexpr float LINE_HEIGHT = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2.0f;
+
+    static double toMiB(const size_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    DebugOverlay::DebugOverlay(SDL_Renderer* sdlRenderer)
+        : m_SdlRenderer(sdlRenderer)
+          , m_Visible(false)
+    {
+    }
+
+    void DebugOverlay::render(const map::MapStats& stats, const float fps, const uint32_t drawCalls) const
+    {
+        if (!m_Visible)
+        {
+            return;
+        }
+
+        std::vector<std::string> lines;
+        lines.push_back(fmt::format("FPS {:.1f} ({:.2f} ms)", fps, fps > 0.0f ? 1000.0f / fps : 0.0f));
+        lines.push_back(fmt::format("Draw calls {}", drawCalls));
+        lines.push_back(fmt::format("CPU {:.2f} MiB  data {:.2f} | renderer {:.2f} | objects {:.2f}",
+                                    toMiB(stats.getCpuBytes()), toMiB(stats.renderDataBytes),
+                                    toMiB(stats.rendererBytes), toMiB(stats.objectBytes)));
+        lines.push_back(fmt::format("GPU {:.2f} MiB  tilesets {:.2f} | overview {:.2f} | lighting {:.2f}",
+                                    toMiB(stats.getGpuBytes()), toMiB(stats.tilesetBytes),
+                                    toMiB(stats.overviewBytes), toMiB(stats.lightingBytes)));
+        lines.push_back(fmt::format("Tilesets {} | animation states {} | lights {}",
+                                    stats.tilesets.size(), stats.animationStates, stats.lightCount));
+
+        std::string chunks = fmt::format("Overview {} regions, chunks", stats.overviewRegions);
+        for (size_t level = 0; level < stats.residentChunks.size(); ++level)
+        {
+            chunks += fmt::format("  L{} {}/{}", level + 1, stats.residentChunks[level], stats.overviewChunks);
+        }
+        lines.push_back(chunks);
+
+        size_t columns = 0;
+        for (const auto& line : lines)
+        {
+            columns = std::max(columns, line.size());
+        }
+
+        SDL_BlendMode previousBlend;
+        SDL_GetRenderDrawBlendMode(m_SdlRenderer, &previousBlend);
+        SDL_SetRenderDrawBlendMode(m_SdlRenderer, SDL_BLENDMODE_BLEND);
+
+        // Backdrop
+        const SDL_FRect backdrop = {
+            MARGIN,
+            MARGIN,
+            static_cast<float>(columns) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + PADDING * 2.0f,
+            static_cast<float>(lines.size()) * LINE_HEIGHT + PADDING * 2.0f
+        };
+        SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 180);
+        SDL_RenderFillRect(m_SdlRenderer, &backdrop);
+
+        SDL_SetRenderDrawColor(m_SdlRenderer, 255, 255, 255, 255);
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            SDL_RenderDebugText(m_SdlRenderer, MARGIN + PADDING, MARGIN + PADDING + static_cast<float>(i) * LINE_HEIGHT,
+                                lines[i].c_str());
+        }
+
+        SDL_SetRenderDrawBlendMode(m_SdlRenderer, previousBlend);
+    }
+}
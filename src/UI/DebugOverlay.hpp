@@ -0,0 +1,34 @@
+#ifndef THEELDERWOODHILL_DEBUGOVERLAY_HPP
+#define THEELDERWOODHILL_DEBUGOVERLAY_HPP
+
+#include <SDL3/SDL.h>
+#include "Map/Telemetry.hpp"
+
+namespace teh::ui
+{
+    /**
+     * @brief Top-left text readout of frame rate, draw calls and map memory
+     */
+    class DebugOverlay
+    {
+    public:
+        explicit DebugOverlay(SDL_Renderer* sdlRenderer);
+
+        /**
+         * @brief Draw the readout
+         * @param stats Map telemetry to display
+         * @param fps Rendered frames per second
+         * @param drawCalls Draw calls of the last frame
+         */
+        void render(const map::MapStats& stats, float fps, uint32_t drawCalls) const;
+
+        void setVisible(bool visible) { m_Visible = visible; }
+        bool isVisible() const { return m_Visible; }
+
+    private:
+        SDL_Renderer* m_SdlRenderer;
+        bool m_Visible;
+    };
+}
+
+#endif //THEELDERWOODHILL_DEBUGOVERLAY_HPP
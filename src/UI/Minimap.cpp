@@ -0,0 +1,49 @@
+#include "Minimap.hpp"
+
+namespace teh::ui
+{
+    Minimap::Minimap(SDL_Renderer* sdlRenderer)
+        : m_SdlRenderer(sdlRenderer)
+          , m_Area{}
+          , m_Visible(true)
+    {
+    }
+
+    void Minimap::render(const map::Map& map, const map::Camera& camera) const
+    {
+        const auto& overview = map.getOverview();
+        if (!m_Visible || !map.isLoaded() || overview.getLevelCount() == 0)
+        {
+            return;
+        }
+
+        const map::Camera fitted = map::Camera::fit(map.getBounds(), m_Area);
+
+        SDL_BlendMode previousBlend;
+        SDL_GetRenderDrawBlendMode(m_SdlRenderer, &previousBlend);
+        SDL_SetRenderDrawBlendMode(m_SdlRenderer, SDL_BLENDMODE_BLEND);
+
+        // Backdrop
+        SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 160);
+        SDL_RenderFillRect(m_SdlRenderer, &m_Area);
+
+        const SDL_Rect clip = {
+            static_cast<int>(m_Area.x),
+            static_cast<int>(m_Area.y),
+            static_cast<int>(m_Area.w),
+            static_cast<int>(m_Area.h)
+        };
+        SDL_SetRenderClipRect(m_SdlRenderer, &clip);
+
+        // The whole map is in view, so parallax layers are shown where they sit at the origin
+        overview.render(overview.getLevelCount(), fitted, false);
+
+        // Outline of the main view
+        const SDL_FRect view = fitted.toScreen(camera.getWorldRect());
+        SDL_SetRenderDrawColor(m_SdlRenderer, 255, 255, 255, 200);
+        SDL_RenderRect(m_SdlRenderer, &view);
+
+        SDL_SetRenderClipRect(m_SdlRenderer, nullptr);
+        SDL_SetRenderDrawBlendMode(m_SdlRenderer, previousBlend);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef THEELDERWOODHILL_MINIMAP_HPP
+#define THEELDERWOODHILL_MINIMAP_HPP
+
+#include <SDL3/SDL.h>
+#include "Map/Map.hpp"
+
+namespace teh::ui
+{
+    /**
+     * @brief Corner overlay showing the whole map and the current view
+     *
+     * Draws the coarsest overview level, so its cost is a handful of small textures.
+     */
+    class Minimap
+    {
+    public:
+        explicit Minimap(SDL_Renderer* sdlRenderer);
+
+        /**
+         * @brief Draw the minimap
+         * @param map Loaded map providing the overview levels
+         * @param camera Main view, outlined on the minimap
+         */
+        void render(const map::Map& map, const map::Camera& camera) const;
+
+        /**
+         * @brief Set the screen-space area the minimap fits into
+         */
+        void setArea(const SDL_FRect& area) { m_Area = area; }
+
+        void setVisible(bool visible) { m_Visible = visible; }
+        bool isVisible() const { return m_Visible; }
+
+    private:
+        SDL_Renderer* m_SdlRenderer;
+        SDL_FRect m_Area;
+        bool m_Visible;
+    };
+}
+
+#endif //THEELDERWOODHILL_MINIMAP_HPP
@@ -0,0 +1,48 @@
+#ifndef THEELDERWOODHILL_MAPPEDFILE_HPP
+#define THEELDERWOODHILL_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace teh::utils
+{
+    /**
+     * @brief Read-only memory mapping of a whole file (mmap, MapViewOfFile on Windows)
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Map a file, replacing any current mapping
+         * @return true if the file exists, is not empty and could be mapped
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmap the file
+         */
+        void close();
+
+        const uint8_t* data() const { return m_Data; }
+        size_t size() const { return m_Size; }
+        bool isOpen() const { return m_Data != nullptr; }
+
+    private:
+        const uint8_t* m_Data{};
+        size_t m_Size{};
+#ifdef _WIN32
+        void* m_Mapping{};
+#endif
+    };
+}
+
+#endif //THEELDERWOODHILL_MAPPEDFILE_HPP
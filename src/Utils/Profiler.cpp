@@ -0,0 +1,102 @@
+#include "Profiler.hpp"
+#include "Logger.hpp"
+#include <SDL3/SDL.h>
+#include <algorithm>
+
+namespace teh::utils
+{
+    std::array<Profiler::Stats, static_cast<size_t>(Profiler::Section::COUNT)> Profiler::s_stats{};
+    uint64_t Profiler::s_frames = 0;
+    bool Profiler::s_enabled = false;
+    std::mutex Profiler::s_mutex;
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        std::lock_guard lock(s_mutex);
+        s_enabled = enabled;
+        s_stats = {};
+        s_frames = 0;
+    }
+
+    void Profiler::record(Section section, uint64_t nanoseconds)
+    {
+        std::lock_guard lock(s_mutex);
+        auto& stats = s_stats[static_cast<size_t>(section)];
+        stats.count++;
+        stats.total += nanoseconds;
+        stats.min = std::min(stats.min, nanoseconds);
+        stats.max = std::max(stats.max, nanoseconds);
+    }
+
+    void Profiler::endFrame()
+    {
+        if (!s_enabled)
+        {
+            return;
+        }
+
+        bool due = false;
+        {
+            std::lock_guard lock(s_mutex);
+            due = ++s_frames % REPORT_INTERVAL == 0;
+        }
+
+        if (due)
+        {
+            report();
+        }
+    }
+
+    void Profiler::report()
+    {
+        if (!s_enabled)
+        {
+            return;
+        }
+
+        std::lock_guard lock(s_mutex);
+        TEH_PERF_LOG(INFO, "Profile at frame {}:", s_frames);
+        for (size_t i = 0; i < s_stats.size(); ++i)
+        {
+            const auto& stats = s_stats[i];
+            if (stats.count == 0)
+                continue;
+
+            TEH_PERF_LOG(INFO, "  {:<8} avg {:.3f} ms | min {:.3f} ms | max {:.3f} ms | {} samples",
+                         getSectionName(static_cast<Section>(i)),
+                         static_cast<double>(stats.total) / stats.count / 1e6,
+                         static_cast<double>(stats.min) / 1e6,
+                         static_cast<double>(stats.max) / 1e6,
+                         stats.count);
+        }
+
+        s_stats = {};
+    }
+
+    const char* Profiler::getSectionName(Section section)
+    {
+        switch (section)
+        {
+        case Section::FRAME: return "FRAME";
+        case Section::EVENTS: return "EVENTS";
+        case Section::UPDATE: return "UPDATE";
+        case Section::RENDER: return "RENDER";
+        case Section::PRESENT: return "PRESENT";
+        default: return "UNKNOWN";
+        }
+    }
+
+    Profiler::Scope::Scope(Section section)
+        : m_Section(section)
+          , m_Start(s_enabled ? SDL_GetTicksNS() : 0)
+    {
+    }
+
+    Profiler::Scope::~Scope()
+    {
+        if (s_enabled)
+        {
+            record(m_Section, SDL_GetTicksNS() - m_Start);
+        }
+    }
+}
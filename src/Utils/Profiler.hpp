@@ -0,0 +1,86 @@
+#ifndef THEELDERWOODHILL_PROFILER_HPP
+#define THEELDERWOODHILL_PROFILER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace teh::utils
+{
+    /**
+     * @brief Lightweight frame-phase profiler reporting through the PERFORMANCE log category
+     *
+     * Sections may be recorded from the simulation and render threads concurrently.
+     */
+    class Profiler
+    {
+    public:
+        // Profiled frame phases
+        enum class Section
+        {
+            FRAME,          // Whole frame excluding frame pacing; the rendered frame when threaded
+            EVENTS,         // Event polling / replay decoding and dispatch
+            UPDATE,         // Simulation
+            RENDER,         // Map and overlay draw submission
+            PRESENT,        // SDL_RenderPresent
+            COUNT
+        };
+
+        // Frames between two automatic reports
+        static constexpr uint32_t REPORT_INTERVAL = 600;
+
+        // Enable or disable sample collection
+        static void setEnabled(bool enabled);
+        static bool isEnabled() { return s_enabled; }
+
+        // Add one timing sample in nanoseconds
+        static void record(Section section, uint64_t nanoseconds);
+
+        // Mark the end of a frame, reporting every REPORT_INTERVAL frames
+        static void endFrame();
+
+        // Log accumulated statistics and reset them
+        static void report();
+
+        // Records the lifetime of the scope into a section
+        class Scope
+        {
+        public:
+            explicit Scope(Section section);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Section m_Section;
+            uint64_t m_Start;
+        };
+
+    private:
+        struct Stats
+        {
+            uint64_t count{};
+            uint64_t total{};
+            uint64_t min{UINT64_MAX};
+            uint64_t max{};
+        };
+
+        static const char* getSectionName(Section section);
+
+        static std::array<Stats, static_cast<size_t>(Section::COUNT)> s_stats;
+        static uint64_t s_frames;
+        static bool s_enabled;
+        static std::mutex s_mutex;
+    };
+}
+
+#define TEH_PROFILE_CONCAT_INNER(a, b) a##b
+#define TEH_PROFILE_CONCAT(a, b) TEH_PROFILE_CONCAT_INNER(a, b)
+
+// Profile the enclosing scope, e.g. TEH_PROFILE_SCOPE(RENDER)
+#define TEH_PROFILE_SCOPE(section) \
+    teh::utils::Profiler::Scope TEH_PROFILE_CONCAT(tehProfileScope, __LINE__)(teh::utils::Profiler::Section::section)
+
+#endif //THEELDERWOODHILL_PROFILER_HPP
@@ -0,0 +1,315 @@
+#include "Replay.hpp"
+#include "Logger.hpp"
+#include <bit>
+#include <cstring>
+#include <iterator>
+
+namespace teh::utils
+{
+    using replay::EventKind;
+
+    bool ReplayRecorder::open(const std::string& filePath)
+    {
+        m_File.open(filePath, std::ios::binary | std::ios::trunc);
+        if (!m_File)
+        {
+            TEH_GAME_LOG(ERROR, "Failed to open replay log for writing: {}", filePath);
+            return false;
+        }
+
+        m_Buffer.assign(std::begin(replay::MAGIC), std::end(replay::MAGIC));
+        m_Buffer.push_back(static_cast<uint8_t>(replay::VERSION & 0xFF));
+        m_Buffer.push_back(static_cast<uint8_t>(replay::VERSION >> 8));
+        m_File.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()));
+        m_Frames = 0;
+
+        TEH_GAME_LOG(INFO, "Recording input to {}", filePath);
+        return true;
+    }
+
+    void ReplayRecorder::writeFrame(const uint32_t deltaTime, const std::vector<SDL_Event>& events)
+    {
+        if (!m_File.is_open())
+        {
+            return;
+        }
+
+        m_Buffer.clear();
+        writeVarint(deltaTime);
+
+        // Count first so unsupported events never reach the log
+        uint64_t count = 0;
+        for (const auto& e : events)
+        {
+            switch (e.type)
+            {
+            case SDL_EVENT_QUIT:
+            case SDL_EVENT_KEY_DOWN:
+            case SDL_EVENT_KEY_UP:
+            case SDL_EVENT_MOUSE_MOTION:
+            case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            case SDL_EVENT_MOUSE_BUTTON_UP:
+            case SDL_EVENT_MOUSE_WHEEL:
+            case SDL_EVENT_WINDOW_RESIZED:
+                count++;
+                break;
+            default:
+                break;
+            }
+        }
+        writeVarint(count);
+
+        for (const auto& e : events)
+        {
+            switch (e.type)
+            {
+            case SDL_EVENT_QUIT:
+                writeByte(static_cast<uint8_t>(EventKind::QUIT));
+                break;
+            case SDL_EVENT_KEY_DOWN:
+            case SDL_EVENT_KEY_UP:
+                writeByte(static_cast<uint8_t>(e.type == SDL_EVENT_KEY_DOWN ? EventKind::KEY_DOWN : EventKind::KEY_UP));
+                writeVarint(e.key.key);
+                writeVarint(static_cast<uint32_t>(e.key.scancode));
+                writeVarint(e.key.mod);
+                writeByte(e.key.repeat ? 1 : 0);
+                break;
+            case SDL_EVENT_MOUSE_MOTION:
+                writeByte(static_cast<uint8_t>(EventKind::MOUSE_MOTION));
+                writeVarint(e.motion.state);
+                writeFloat(e.motion.x);
+                writeFloat(e.motion.y);
+                writeFloat(e.motion.xrel);
+                writeFloat(e.motion.yrel);
+                break;
+            case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            case SDL_EVENT_MOUSE_BUTTON_UP:
+                writeByte(static_cast<uint8_t>(e.type == SDL_EVENT_MOUSE_BUTTON_DOWN
+                                                   ? EventKind::MOUSE_BUTTON_DOWN
+                                                   : EventKind::MOUSE_BUTTON_UP));
+                writeByte(e.button.button);
+                writeByte(e.button.clicks);
+                writeFloat(e.button.x);
+                writeFloat(e.button.y);
+                break;
+            case SDL_EVENT_MOUSE_WHEEL:
+                writeByte(static_cast<uint8_t>(EventKind::MOUSE_WHEEL));
+                writeByte(static_cast<uint8_t>(e.wheel.direction));
+                writeFloat(e.wheel.x);
+                writeFloat(e.wheel.y);
+                writeFloat(e.wheel.mouse_x);
+                writeFloat(e.wheel.mouse_y);
+                break;
+            case SDL_EVENT_WINDOW_RESIZED:
+                writeByte(static_cast<uint8_t>(EventKind::WINDOW_RESIZED));
+                writeVarint(static_cast<uint32_t>(e.window.data1));
+                writeVarint(static_cast<uint32_t>(e.window.data2));
+                break;
+            default:
+                break;
+            }
+        }
+
+        m_File.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()));
+        m_Frames++;
+    }
+
+    void ReplayRecorder::close()
+    {
+        if (!m_File.is_open())
+        {
+            return;
+        }
+
+        m_File.close();
+        TEH_GAME_LOG(INFO, "Replay log closed after {} frames", m_Frames);
+    }
+
+    void ReplayRecorder::writeVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_Buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_Buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    void ReplayRecorder::writeFloat(const float value)
+    {
+        const auto bits = std::bit_cast<uint32_t>(value);
+        for (int i = 0; i < 4; ++i)
+        {
+            m_Buffer.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+        }
+    }
+
+    void ReplayRecorder::writeByte(const uint8_t value)
+    {
+        m_Buffer.push_back(value);
+    }
+
+    bool ReplayPlayer::open(const std::string& filePath)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file)
+        {
+            TEH_GAME_LOG(ERROR, "Failed to open replay log: {}", filePath);
+            return false;
+        }
+
+        m_Data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_Offset = 0;
+        m_Frames = 0;
+
+        constexpr size_t headerSize = sizeof(replay::MAGIC) + sizeof(uint16_t);
+        if (m_Data.size() < headerSize || std::memcmp(m_Data.data(), replay::MAGIC, sizeof(replay::MAGIC)) != 0)
+        {
+            TEH_GAME_LOG(ERROR, "Not a replay log: {}", filePath);
+            return false;
+        }
+
+        const uint16_t version = static_cast<uint16_t>(m_Data[4] | m_Data[5] << 8);
+        if (version != replay::VERSION)
+        {
+            TEH_GAME_LOG(ERROR, "Unsupported replay log version {} (expected {})", version, replay::VERSION);
+            return false;
+        }
+
+        m_Offset = headerSize;
+        TEH_GAME_LOG(INFO, "Replaying input from {} ({} bytes)", filePath, m_Data.size());
+        return true;
+    }
+
+    bool ReplayPlayer::readFrame(uint32_t& deltaTime, std::vector<SDL_Event>& events)
+    {
+        if (m_Offset >= m_Data.size())
+        {
+            return false;
+        }
+
+        uint64_t delta = 0;
+        uint64_t count = 0;
+        if (!readVarint(delta) || !readVarint(count))
+        {
+            TEH_GAME_LOG(WARN, "Truncated replay frame header at frame {}", m_Frames);
+            return false;
+        }
+        deltaTime = static_cast<uint32_t>(delta);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            SDL_Event e;
+            std::memset(&e, 0, sizeof(e));
+
+            uint8_t kind = 0;
+            bool ok = readByte(kind);
+            uint64_t a = 0, b = 0, c = 0;
+            uint8_t flag = 0, extra = 0;
+
+            switch (static_cast<EventKind>(kind))
+            {
+            case EventKind::QUIT:
+                e.type = SDL_EVENT_QUIT;
+                break;
+            case EventKind::KEY_DOWN:
+            case EventKind::KEY_UP:
+                e.type = static_cast<EventKind>(kind) == EventKind::KEY_DOWN ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+                ok = ok && readVarint(a) && readVarint(b) && readVarint(c) && readByte(flag);
+                e.key.key = static_cast<SDL_Keycode>(a);
+                e.key.scancode = static_cast<SDL_Scancode>(b);
+                e.key.mod = static_cast<SDL_Keymod>(c);
+                e.key.down = e.type == SDL_EVENT_KEY_DOWN;
+                e.key.repeat = flag != 0;
+                break;
+            case EventKind::MOUSE_MOTION:
+                e.type = SDL_EVENT_MOUSE_MOTION;
+                ok = ok && readVarint(a) && readFloat(e.motion.x) && readFloat(e.motion.y)
+                    && readFloat(e.motion.xrel) && readFloat(e.motion.yrel);
+                e.motion.state = static_cast<SDL_MouseButtonFlags>(a);
+                break;
+            case EventKind::MOUSE_BUTTON_DOWN:
+            case EventKind::MOUSE_BUTTON_UP:
+                e.type = static_cast<EventKind>(kind) == EventKind::MOUSE_BUTTON_DOWN
+                             ? SDL_EVENT_MOUSE_BUTTON_DOWN
+                             : SDL_EVENT_MOUSE_BUTTON_UP;
+                ok = ok && readByte(flag) && readByte(extra) && readFloat(e.button.x) && readFloat(e.button.y);
+                e.button.button = flag;
+                e.button.clicks = extra;
+                e.button.down = e.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+                break;
+            case EventKind::MOUSE_WHEEL:
+                e.type = SDL_EVENT_MOUSE_WHEEL;
+                ok = ok && readByte(flag) && readFloat(e.wheel.x) && readFloat(e.wheel.y)
+                    && readFloat(e.wheel.mouse_x) && readFloat(e.wheel.mouse_y);
+                e.wheel.direction = static_cast<SDL_MouseWheelDirection>(flag);
+                break;
+            case EventKind::WINDOW_RESIZED:
+                e.type = SDL_EVENT_WINDOW_RESIZED;
+                ok = ok && readVarint(a) && readVarint(b);
+                e.window.data1 = static_cast<Sint32>(a);
+                e.window.data2 = static_cast<Sint32>(b);
+                break;
+            default:
+                ok = false;
+                break;
+            }
+
+            if (!ok)
+            {
+                TEH_GAME_LOG(WARN, "Corrupt replay event at frame {}", m_Frames);
+                return false;
+            }
+            events.push_back(e);
+        }
+
+        m_Frames++;
+        return true;
+    }
+
+    bool ReplayPlayer::readVarint(uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = 0;
+            if (!readByte(byte))
+            {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReplayPlayer::readFloat(float& value)
+    {
+        if (m_Data.size() - m_Offset < 4)
+        {
+            return false;
+        }
+
+        uint32_t bits = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            bits |= static_cast<uint32_t>(m_Data[m_Offset++]) << (i * 8);
+        }
+        value = std::bit_cast<float>(bits);
+        return true;
+    }
+
+    bool ReplayPlayer::readByte(uint8_t& value)
+    {
+        if (m_Offset >= m_Data.size())
+        {
+            return false;
+        }
+
+        value = m_Data[m_Offset++];
+        return true;
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef THEELDERWOODHILL_REPLAY_HPP
+#define THEELDERWOODHILL_REPLAY_HPP
+
+#include <SDL3/SDL.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace teh::utils
+{
+    /**
+     * @brief Binary input log shared by ReplayRecorder and ReplayPlayer
+     *
+     * Layout: "TEHR" magic, u16 version, then one record per frame:
+     * varint frame delta (ms), varint event count, then each event as a
+     * u8 kind followed by its kind-specific payload. Only events the game
+     * reacts to are stored; everything else is dropped at record time.
+     */
+    namespace replay
+    {
+        constexpr char MAGIC[4] = {'T', 'E', 'H', 'R'};
+        constexpr uint16_t VERSION = 1;
+
+        enum class EventKind : uint8_t
+        {
+            QUIT,
+            KEY_DOWN,
+            KEY_UP,
+            MOUSE_MOTION,
+            MOUSE_BUTTON_DOWN,
+            MOUSE_BUTTON_UP,
+            MOUSE_WHEEL,
+            WINDOW_RESIZED
+        };
+    }
+
+    /**
+     * @brief Writes every frame's delta and input events to a replay log
+     */
+    class ReplayRecorder
+    {
+    public:
+        /**
+         * @brief Create the log file and write its header
+         * @return true if the file is ready for writing
+         */
+        bool open(const std::string& filePath);
+
+        /**
+         * @brief Append one frame
+         * @param deltaTime Frame delta in milliseconds
+         * @param events Events polled this frame
+         */
+        void writeFrame(uint32_t deltaTime, const std::vector<SDL_Event>& events);
+
+        void close();
+
+        uint64_t getFrameCount() const { return m_Frames; }
+
+    private:
+        void writeVarint(uint64_t value);
+        void writeFloat(float value);
+        void writeByte(uint8_t value);
+
+        std::ofstream m_File;
+        std::vector<uint8_t> m_Buffer;
+        uint64_t m_Frames{};
+    };
+
+    /**
+     * @brief Feeds a recorded log back frame by frame
+     */
+    class ReplayPlayer
+    {
+    public:
+        /**
+         * @brief Read the whole log into memory and validate its header
+         * @return true if the log can be replayed
+         */
+        bool open(const std::string& filePath);
+
+        /**
+         * @brief Decode the next frame
+         * @param deltaTime Receives the recorded frame delta in milliseconds
+         * @param events Receives the recorded events (appended)
+         * @return false once the log is exhausted or corrupt
+         */
+        bool readFrame(uint32_t& deltaTime, std::vector<SDL_Event>& events);
+
+        uint64_t getFrameCount() const { return m_Frames; }
+
+    private:
+        bool readVarint(uint64_t& value);
+        bool readFloat(float& value);
+        bool readByte(uint8_t& value);
+
+        std::vector<uint8_t> m_Data;
+        size_t m_Offset{};
+        uint64_t m_Frames{};
+    };
+}
+
+#endif //THEELDERWOODHILL_REPLAY_HPP
@@ -0,0 +1,272 @@
+#include "TextureCache.hpp"
+#include "Logger.hpp"
+#include <SDL3_image/SDL_image.h>
+#include <ankerl/unordered_dense.h>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace teh::utils
+{
+    static constexpr char CACHE_MAGIC[4] = {'T', 'E', 'H', 'T'};
+
+    /**
+     * @brief Temp file name no other writer of the same entry uses, in this process or another one
+     */
+    static std::string makeTempPath(const std::string& entryPath)
+    {
+        static std::atomic<uint32_t> counter{0};
+#ifdef _WIN32
+        const auto processId = static_cast<uint64_t>(GetCurrentProcessId());
+#else
+        const auto processId = static_cast<uint64_t>(getpid());
+#endif
+        return fmt::format("{}.{}.{}.tmp", entryPath, processId, counter.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    TextureCache::Image::~Image()
+    {
+        reset();
+    }
+
+    void TextureCache::Image::reset()
+    {
+        m_File.close();
+        if (m_Surface)
+        {
+            SDL_DestroySurface(m_Surface);
+            m_Surface = nullptr;
+        }
+        m_Pixels = nullptr;
+        m_Width = 0;
+        m_Height = 0;
+        m_Pitch = 0;
+    }
+
+    TextureCache::TextureCache(std::string directory)
+        : m_Directory(std::move(directory))
+    {
+        if (m_Directory.empty())
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+        if (error)
+        {
+            TEH_RESOURCE_LOG(WARN, "Texture cache disabled, cannot create {}: {}", m_Directory, error.message());
+            m_Directory.clear();
+            return;
+        }
+
+        TEH_RESOURCE_LOG(INFO, "Texture cache: {}", m_Directory);
+    }
+
+    bool TextureCache::load(const std::string& imagePath, Image& image)
+    {
+        if (!isEnabled())
+        {
+            return decode(imagePath, image);
+        }
+
+        size_t size = 0;
+        void* data = SDL_LoadFile(imagePath.c_str(), &size);
+        if (!data)
+        {
+            TEH_RESOURCE_LOG(ERROR, "Failed to read image: {} | SDL Error: {}", imagePath, SDL_GetError());
+            return false;
+        }
+
+        // Hashing the compressed file is far cheaper than inflating it
+        const uint64_t hash = ankerl::unordered_dense::hash<std::string_view>{}(
+            std::string_view(static_cast<const char*>(data), size));
+        const std::string entryPath = getEntryPath(hash);
+
+        if (read(entryPath, hash, size, image))
+        {
+            SDL_free(data);
+            TEH_RESOURCE_LOG(DEBUG, "Texture cache hit: {} ({}x{})", imagePath, image.getWidth(), image.getHeight());
+            return true;
+        }
+
+        const bool decoded = decodeMemory(data, size, image);
+        SDL_free(data);
+        if (!decoded)
+        {
+            TEH_RESOURCE_LOG(ERROR, "Failed to decode image: {} | SDL Error: {}", imagePath, SDL_GetError());
+            return false;
+        }
+
+        TEH_RESOURCE_LOG(DEBUG, "Texture cache miss: {}, storing {}", imagePath, entryPath);
+        write(entryPath, hash, size, image);
+        return true;
+    }
+
+    bool TextureCache::decode(const std::string& imagePath, Image& image)
+    {
+        size_t size = 0;
+        void* data = SDL_LoadFile(imagePath.c_str(), &size);
+        if (!data)
+        {
+            TEH_RESOURCE_LOG(ERROR, "Failed to read image: {} | SDL Error: {}", imagePath, SDL_GetError());
+            return false;
+        }
+
+        const bool decoded = decodeMemory(data, size, image);
+        SDL_free(data);
+        if (!decoded)
+        {
+            TEH_RESOURCE_LOG(ERROR, "Failed to decode image: {} | SDL Error: {}", imagePath, SDL_GetError());
+        }
+        return decoded;
+    }
+
+    bool TextureCache::decodeMemory(const void* data, const size_t size, Image& image)
+    {
+        image.reset();
+
+        SDL_Surface* loaded = IMG_Load_IO(SDL_IOFromConstMem(data, size), true);
+        if (!loaded)
+        {
+            return false;
+        }
+
+        SDL_Surface* converted = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!converted)
+        {
+            return false;
+        }
+
+        if (!SDL_PremultiplySurfaceAlpha(converted, false))
+        {
+            SDL_DestroySurface(converted);
+            return false;
+        }
+
+        image.m_Surface = converted;
+        image.m_Pixels = converted->pixels;
+        image.m_Width = converted->w;
+        image.m_Height = converted->h;
+        image.m_Pitch = converted->pitch;
+        return true;
+    }
+
+    std::string TextureCache::getDefaultDirectory()
+    {
+        char* prefPath = SDL_GetPrefPath("teh", "TheElderwoodHill");
+        if (!prefPath)
+        {
+            return {};
+        }
+
+        std::string directory = std::string(prefPath) + "texture-cache";
+        SDL_free(prefPath);
+        return directory;
+    }
+
+    std::string TextureCache::getEntryPath(const uint64_t hash) const
+    {
+        return (std::filesystem::path(m_Directory) / fmt::format("{:016x}.v{}.rgba", hash, FORMAT_VERSION)).string();
+    }
+
+    bool TextureCache::read(const std::string& entryPath, const uint64_t hash, const uint64_t size, Image& image) const
+    {
+        image.reset();
+
+        MappedFile file;
+        if (!file.open(entryPath) || file.size() < PIXEL_OFFSET)
+        {
+            return false;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        const uint64_t pixelBytes = static_cast<uint64_t>(header.pitch) * header.height;
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+            header.version != FORMAT_VERSION ||
+            header.sourceHash != hash ||
+            header.sourceSize != size ||
+            header.width == 0 || header.height == 0 ||
+            header.pitch != header.width * 4 ||
+            header.pixelOffset != PIXEL_OFFSET ||
+            header.pixelOffset + pixelBytes > file.size())
+        {
+            TEH_RESOURCE_LOG(WARN, "Ignoring invalid texture cache entry {}", entryPath);
+            return false;
+        }
+
+        image.m_Pixels = file.data() + header.pixelOffset;
+        image.m_Width = static_cast<int>(header.width);
+        image.m_Height = static_cast<int>(header.height);
+        image.m_Pitch = static_cast<int>(header.pitch);
+        image.m_File = std::move(file);
+        return true;
+    }
+
+    void TextureCache::write(const std::string& entryPath, const uint64_t hash, const uint64_t size, const Image& image) const
+    {
+        FileHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = FORMAT_VERSION;
+        header.sourceHash = hash;
+        header.sourceSize = size;
+        header.width = static_cast<uint32_t>(image.getWidth());
+        header.height = static_cast<uint32_t>(image.getHeight());
+        header.pitch = header.width * 4;
+        header.pixelOffset = PIXEL_OFFSET;
+
+        // Write beside the entry and rename, so a crash never leaves a truncated entry behind.
+        // Each writer gets its own temp file: processes sharing the cache directory must not
+        // interleave writes into one file and rename the torn result into place
+        const std::string tempPath = makeTempPath(entryPath);
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                TEH_RESOURCE_LOG(WARN, "Cannot write texture cache entry {}", tempPath);
+                return;
+            }
+
+            std::vector<char> prefix(PIXEL_OFFSET, 0);
+            std::memcpy(prefix.data(), &header, sizeof(header));
+            out.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+
+            // Rows are stored tightly packed, whatever the surface pitch
+            const auto* pixels = static_cast<const char*>(image.getPixels());
+            for (int y = 0; y < image.getHeight(); ++y)
+            {
+                out.write(pixels + static_cast<size_t>(y) * image.getPitch(), header.pitch);
+            }
+
+            if (!out)
+            {
+                TEH_RESOURCE_LOG(WARN, "Failed writing texture cache entry {}", tempPath);
+                out.close();
+                std::filesystem::remove(tempPath);
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, entryPath, error);
+        if (error)
+        {
+            TEH_RESOURCE_LOG(WARN, "Cannot store texture cache entry {}: {}", entryPath, error.message());
+            std::filesystem::remove(tempPath, error);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef THEELDERWOODHILL_TEXTURECACHE_HPP
+#define THEELDERWOODHILL_TEXTURECACHE_HPP
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <string>
+#include "MappedFile.hpp"
+
+namespace teh::utils
+{
+    /**
+     * @brief On-disk cache of decoded tileset images
+     *
+     * Images are stored as raw premultiplied RGBA32 rows behind a small header and
+     * keyed by a hash of the source file's bytes, so an edited PNG gets a new entry.
+     * A hit maps the cache file and hands out pointers into the mapped pages,
+     * skipping PNG decode entirely. Entries are never evicted; delete the directory
+     * to reclaim the space.
+     */
+    class TextureCache
+    {
+    public:
+        // Bump when the file layout or the pixel processing changes
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        /**
+         * @brief Premultiplied RGBA32 pixels, backed by a mapped cache file or a decoded surface
+         */
+        class Image
+        {
+        public:
+            Image() = default;
+            ~Image();
+
+            Image(const Image&) = delete;
+            Image& operator=(const Image&) = delete;
+
+            int getWidth() const { return m_Width; }
+            int getHeight() const { return m_Height; }
+            int getPitch() const { return m_Pitch; }
+            const void* getPixels() const { return m_Pixels; }
+
+            /**
+             * @brief true if the pixels come straight from the cache file
+             */
+            bool isMapped() const { return m_File.isOpen(); }
+
+        private:
+            friend class TextureCache;
+
+            void reset();
+
+            MappedFile m_File;
+            SDL_Surface* m_Surface{};
+            const void* m_Pixels{};
+            int m_Width{};
+            int m_Height{};
+            int m_Pitch{};
+        };
+
+        /**
+         * @param directory Cache directory, created on demand; empty disables caching
+         */
+        explicit TextureCache(std::string directory);
+
+        /**
+         * @brief Load an image, from the cache if possible, decoding and storing it otherwise
+         * @return true if the image was loaded
+         */
+        bool load(const std::string& imagePath, Image& image);
+
+        /**
+         * @brief Decode an image without touching any cache
+         */
+        static bool decode(const std::string& imagePath, Image& image);
+
+        /**
+         * @brief Per-user cache directory, or an empty string if none is available
+         */
+        static std::string getDefaultDirectory();
+
+        bool isEnabled() const { return !m_Directory.empty(); }
+
+    private:
+        struct FileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceHash;
+            uint64_t sourceSize;
+            uint32_t width;
+            uint32_t height;
+            uint32_t pitch;
+            uint32_t pixelOffset;
+        };
+
+        // Pixel rows start at this file offset, keeping them aligned in the mapping
+        static constexpr uint32_t PIXEL_OFFSET = 64;
+        static_assert(sizeof(FileHeader) <= PIXEL_OFFSET);
+
+        static bool decodeMemory(const void* data, size_t size, Image& image);
+
+        std::string getEntryPath(uint64_t hash) const;
+        bool read(const std::string& entryPath, uint64_t hash, uint64_t size, Image& image) const;
+        void write(const std::string& entryPath, uint64_t hash, uint64_t size, const Image& image) const;
+
+        std::string m_Directory;
+    };
+}
+
+#endif //THEELDERWOODHILL_TEXTURECACHE_HPP
@@ -0,0 +1,69 @@
+#ifndef THEELDERWOODHILL_TRIPLEBUFFER_HPP
+#define THEELDERWOODHILL_TRIPLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace teh::utils
+{
+    /**
+     * @brief Lock-free single producer / single consumer triple buffer
+     *
+     * The producer fills the write slot and publishes it; the consumer picks up
+     * the newest published slot. Neither side ever waits for the other, and
+     * values published faster than they are consumed are simply skipped.
+     */
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        /**
+         * @brief Producer: slot to fill before publish()
+         */
+        T& getWriteBuffer() { return m_Slots[m_Write]; }
+
+        /**
+         * @brief Producer: make the write slot the newest value and take a free slot
+         */
+        void publish()
+        {
+            uint8_t previous = m_Shared.exchange(static_cast<uint8_t>(m_Write | DIRTY_BIT), std::memory_order_acq_rel);
+            m_Write = previous & INDEX_MASK;
+        }
+
+        /**
+         * @brief Consumer: swap in the newest published value
+         * @return true if a new value was published since the last call
+         */
+        bool update()
+        {
+            if (!(m_Shared.load(std::memory_order_relaxed) & DIRTY_BIT))
+            {
+                return false;
+            }
+
+            uint8_t previous = m_Shared.exchange(m_Read, std::memory_order_acq_rel);
+            m_Read = previous & INDEX_MASK;
+            return true;
+        }
+
+        /**
+         * @brief Consumer: value picked up by the last successful update()
+         */
+        const T& getReadBuffer() const { return m_Slots[m_Read]; }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x3;
+        static constexpr uint8_t DIRTY_BIT = 0x4;
+
+        std::array<T, 3> m_Slots{};
+
+        // Index of the slot between producer and consumer, plus the dirty bit
+        alignas(64) std::atomic<uint8_t> m_Shared{1};
+        alignas(64) uint8_t m_Write{0};     // Producer only
+        alignas(64) uint8_t m_Read{2};      // Consumer only
+    };
+}
+
+#endif //THEELDERWOODHILL_TRIPLEBUFFER_HPP
@@ -1,9 +1,44 @@
 #include "Game.hpp"
+#include <cstring>
+#include <iostream>
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --record <file>     Record input and frame timing to <file>\n"
+              << "  --replay <file>     Replay a recorded log (unthrottled, profiler on)\n"
+              << "  --headless          Hidden window with software rendering\n"
+              << "  --profile           Log frame-phase timings\n"
+              << "  --gpu               Draw tiles with the SDL_GPU backend (falls back to SDL_Renderer)\n"
+              << "  --no-texture-cache  Decode tileset images on every start\n";
+}
 
 int main(int argc, char* argv[]) {
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replayPath = argv[++i];
+            options.profile = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            options.profile = true;
+        } else if (std::strcmp(argv[i], "--gpu") == 0) {
+            options.gpu = true;
+        } else if (std::strcmp(argv[i], "--no-texture-cache") == 0) {
+            options.textureCache = false;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
     Game game;
 
-    if (game.init()) {
+    if (game.init(options)) {
         game.run();
     }
 